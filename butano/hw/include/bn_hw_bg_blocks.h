@@ -79,6 +79,17 @@ namespace bn::hw::bg_blocks
         BFN_SET(source_cell, palette_bank + palette_offset, SE_PALBANK);
         destination_cell = uint16_t(source_cell);
     }
+
+    // Cells are processed in pairs packed in 32-bit words, but they don't need to be word aligned:
+    // a leading destination cell is copied alone, and unaligned source cells are read one by one.
+    BN_CODE_IWRAM void copy_regular_bg_map_cells_offset(
+            const uint16_t* source_cells_ptr, int cells_count, unsigned tiles_offset, unsigned palette_offset,
+            uint16_t* destination_cells_ptr);
+
+    // Cells are read and written one by one, so they don't need to be word aligned:
+    BN_CODE_IWRAM void copy_regular_bg_map_col_offset(
+            const uint16_t* source_cells_ptr, int source_stride, int cells_count, unsigned tiles_offset,
+            unsigned palette_offset, uint16_t* destination_cells_ptr);
 }
 
 #endif
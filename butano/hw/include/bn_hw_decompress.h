@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2020 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_HW_DECOMPRESS_H
+#define BN_HW_DECOMPRESS_H
+
+#include "bn_hw_tonc.h"
+
+namespace bn::hw::decompress
+{
+    [[nodiscard]] inline int decompressed_size(const void* source)
+    {
+        return int(*static_cast<const unsigned*>(source) >> 8);
+    }
+
+    inline void lz77_vram(const void* source, void* destination)
+    {
+        LZ77UnCompVram(source, destination);
+    }
+
+    inline void rl_vram(const void* source, void* destination)
+    {
+        RLUnCompVram(source, destination);
+    }
+
+    inline void huff(const void* source, void* destination)
+    {
+        HuffUnComp(source, destination);
+    }
+}
+
+#endif
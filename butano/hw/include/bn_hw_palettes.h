@@ -38,41 +38,60 @@ namespace bn::hw::palettes
         }
     }
 
-    inline void brightness(int value, int count, color* colors_ptr)
+    inline void invert(int count, color* colors_ptr)
     {
-        auto tonc_colors_ptr = reinterpret_cast<COLOR*>(colors_ptr);
-        clr_adj_brightness(tonc_colors_ptr, tonc_colors_ptr, unsigned(count), value);
-    }
+        auto words_ptr = reinterpret_cast<unsigned*>(colors_ptr);
 
-    inline void contrast(int value, int count, color* colors_ptr)
-    {
-        auto tonc_colors_ptr = reinterpret_cast<COLOR*>(colors_ptr);
-        clr_adj_contrast(tonc_colors_ptr, tonc_colors_ptr, unsigned(count), value);
-    }
+        for(int index = 0, limit = count / 2; index < limit; ++index)
+        {
+            words_ptr[index] ^= 0x7FFF7FFF;
+        }
 
-    inline void intensity(int value, int count, color* colors_ptr)
-    {
-        auto tonc_colors_ptr = reinterpret_cast<COLOR*>(colors_ptr);
-        clr_adj_intensity(tonc_colors_ptr, tonc_colors_ptr, unsigned(count), value);
+        if(count & 1)
+        {
+            auto tonc_colors_ptr = reinterpret_cast<COLOR*>(colors_ptr);
+            tonc_colors_ptr[count - 1] = 32767 ^ tonc_colors_ptr[count - 1];
+        }
     }
 
-    inline void invert(int count, color* colors_ptr)
+    inline void fill_channels_lut(int brightness, int contrast, int intensity, bool inverted, uint8_t* channels_lut)
     {
-        auto tonc_colors_ptr = reinterpret_cast<COLOR*>(colors_ptr);
+        // Same operations as clr_adj_brightness, clr_adj_contrast and clr_adj_intensity, applied to each channel:
+        int contrast_a = contrast + FIX_ONE;
+        int contrast_b = (-contrast >> 1) * 32;
+        int intensity_a = intensity + FIX_ONE;
 
-        for(int index = 0; index < count; ++index)
+        for(int value = 0; value < 32; ++value)
         {
-            tonc_colors_ptr[index] = 32767 ^ tonc_colors_ptr[index];
+            int channel = value;
+
+            if(brightness)
+            {
+                channel = int(bf_clamp(channel + (brightness >> 3), 5));
+            }
+
+            if(contrast)
+            {
+                channel = int(bf_clamp((contrast_a * channel + contrast_b) >> 8, 5));
+            }
+
+            if(intensity)
+            {
+                channel = int(bf_clamp((intensity_a * channel) >> 8, 5));
+            }
+
+            if(inverted)
+            {
+                channel = 31 - channel;
+            }
+
+            channels_lut[value] = uint8_t(channel);
         }
     }
 
-    inline void grayscale(int intensity, int count, color* colors_ptr)
-    {
-        auto tonc_colors_ptr = reinterpret_cast<COLOR*>(colors_ptr);
-        COLOR temp_colors[colors()];
-        clr_grayscale(temp_colors, tonc_colors_ptr, unsigned(count));
-        clr_blend_fast(tonc_colors_ptr, temp_colors, tonc_colors_ptr, unsigned(count), unsigned(intensity));
-    }
+    BN_CODE_IWRAM void apply_channels_lut(const uint8_t* channels_lut, int count, color* colors_ptr);
+
+    BN_CODE_IWRAM void grayscale(int intensity, int count, color* colors_ptr);
 
     inline void fade(color fade_color, int intensity, int count, color* colors_ptr)
     {
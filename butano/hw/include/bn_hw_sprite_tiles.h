@@ -8,7 +8,8 @@
 
 #include "bn_tile.h"
 #include "bn_memory.h"
-#include "bn_hw_tonc.h"
+#include "bn_compression_type.h"
+#include "bn_hw_decompress.h"
 
 namespace bn::hw::sprite_tiles
 {
@@ -43,6 +44,33 @@ namespace bn::hw::sprite_tiles
         memory::copy(*source_tiles_ptr, count, *tile_vram(index));
     }
 
+    inline void commit(const tile* source_tiles_ptr, compression_type compression, int index, int count)
+    {
+        switch(compression)
+        {
+
+        case compression_type::NONE:
+            commit(source_tiles_ptr, index, count);
+            break;
+
+        case compression_type::LZ77:
+            decompress::lz77_vram(source_tiles_ptr, tile_vram(index));
+            break;
+
+        case compression_type::RUN_LENGTH:
+            decompress::rl_vram(source_tiles_ptr, tile_vram(index));
+            break;
+
+        case compression_type::HUFFMAN:
+            decompress::huff(source_tiles_ptr, tile_vram(index));
+            break;
+
+        default:
+            BN_ERROR("Unknown compression type: ", int(compression));
+            break;
+        }
+    }
+
     BN_CODE_IWRAM void plot_tiles(int width, const tile* source_tiles_ptr, int source_height, int source_y,
                                    int destination_y, tile* destination_tiles_ptr);
 }
@@ -168,6 +168,11 @@ namespace bn::hw::sprites
         BFN_SET(sprite.attr1, int(shape_size.size()), ATTR1_SIZE);
     }
 
+    [[nodiscard]] inline int tiles_id(const handle_type& sprite)
+    {
+        return BFN_GET(sprite.attr2, ATTR2_ID);
+    }
+
     inline void set_tiles(int tiles_id, handle_type& sprite)
     {
         BFN_SET(sprite.attr2, tiles_id, ATTR2_ID);
@@ -307,7 +312,9 @@ namespace bn::hw::sprites
 
     inline void commit(const handle_type& sprites_ref, int offset, int count)
     {
-        memory::copy((&sprites_ref)[offset], count, vram()[offset]);
+        // DMA0 is used because DMA3 is reserved for HDMA:
+        constexpr int words_per_handle = int(sizeof(handle_type) / sizeof(unsigned));
+        DMA_TRANSFER(vram() + offset, &sprites_ref + offset, count * words_per_handle, 0, DMA_CPY32);
     }
 
     [[nodiscard]] inline uint16_t* first_attributes_register(int id)
@@ -24,6 +24,21 @@ namespace bn::hw::sprites
     {
         return 3;
     }
+
+    [[nodiscard]] constexpr int max_scanline_cycles()
+    {
+        return 1210;
+    }
+
+    [[nodiscard]] constexpr int regular_cycles(int width)
+    {
+        return width;
+    }
+
+    [[nodiscard]] constexpr int affine_cycles(int width)
+    {
+        return (width * 2) + 10;
+    }
 }
 
 #endif
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2020 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_HW_SPRITES_MULTIPLEXING_H
+#define BN_HW_SPRITES_MULTIPLEXING_H
+
+#include "bn_config_sprites.h"
+#include "bn_hw_irq.h"
+#include "bn_hw_sprites.h"
+#include "bn_hw_sprites_constants.h"
+#include "bn_hw_display_constants.h"
+
+namespace bn::hw::sprites_multiplexing
+{
+    static_assert(BN_CFG_SPRITES_MULTIPLEXING_BANDS >= 2 && BN_CFG_SPRITES_MULTIPLEXING_BANDS <= 8);
+
+    [[nodiscard]] constexpr int bands_count()
+    {
+        return BN_CFG_SPRITES_MULTIPLEXING_BANDS;
+    }
+
+    /*
+     * OAM entries of a band are rewritten this number of scanlines before the band starts,
+     * so the rewrite is finished before the PPU fetches the sprites of the first scanline of the band.
+     */
+    [[nodiscard]] constexpr int guard_lines()
+    {
+        return 3;
+    }
+
+    [[nodiscard]] constexpr int band(int y)
+    {
+        return (y * bands_count()) / display::height();
+    }
+
+    [[nodiscard]] constexpr int band_top(int band)
+    {
+        return ((band * display::height()) + bands_count() - 1) / bands_count();
+    }
+
+    [[nodiscard]] constexpr int band_vcount(int band)
+    {
+        return band_top(band) - guard_lines();
+    }
+
+    static_assert(band_vcount(1) > 0);
+
+
+    class entry
+    {
+
+    public:
+        uint16_t attr0;
+        uint16_t attr1;
+        uint16_t attr2;
+        uint16_t index;
+    };
+
+
+    class band_entries
+    {
+
+    public:
+        entry entries[sprites::count()];
+        int entries_count = 0;
+    };
+
+
+    class bands
+    {
+
+    public:
+        band_entries items[bands_count() - 1];
+        int first_index = sprites::count();
+        int last_index = -1;
+
+        void reset()
+        {
+            for(band_entries& band_entries_ref : items)
+            {
+                band_entries_ref.entries_count = 0;
+            }
+
+            first_index = sprites::count();
+            last_index = -1;
+        }
+
+        [[nodiscard]] bool empty() const
+        {
+            return last_index < 0;
+        }
+
+        void push_back(int band, int index, const sprites::handle_type& handle)
+        {
+            band_entries& band_entries_ref = items[band - 1];
+            entry& entry_ref = band_entries_ref.entries[band_entries_ref.entries_count];
+            entry_ref.attr0 = handle.attr0;
+            entry_ref.attr1 = handle.attr1;
+            entry_ref.attr2 = handle.attr2;
+            entry_ref.index = uint16_t(index);
+            ++band_entries_ref.entries_count;
+
+            if(index < first_index)
+            {
+                first_index = index;
+            }
+
+            if(index > last_index)
+            {
+                last_index = index;
+            }
+        }
+    };
+
+    BN_CODE_IWRAM void commit_bands(const bands& bands_ref);
+
+    BN_CODE_IWRAM void _intr();
+
+    inline void init(const bands& bands_ref)
+    {
+        commit_bands(bands_ref);
+        irq::replace_or_push_back(irq::id::VCOUNT, _intr);
+        irq::disable(irq::id::VCOUNT);
+    }
+
+    inline void enable()
+    {
+        REG_DISPSTAT = uint16_t((REG_DISPSTAT & ~DSTAT_VCT_MASK) | DSTAT_VCT(band_vcount(1)));
+        irq::enable(irq::id::VCOUNT);
+    }
+
+    inline void disable()
+    {
+        irq::disable(irq::id::VCOUNT);
+    }
+}
+
+#endif
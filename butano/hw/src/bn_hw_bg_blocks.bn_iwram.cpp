@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2020 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "../include/bn_hw_bg_blocks.h"
+
+namespace bn::hw::bg_blocks
+{
+
+namespace
+{
+    constexpr unsigned tile_ids_mask = SE_ID_MASK | (SE_ID_MASK << 16);
+    constexpr unsigned flips_mask = (SE_HFLIP | SE_VFLIP) | ((SE_HFLIP | SE_VFLIP) << 16);
+    constexpr unsigned palette_banks_mask = (SE_PALBANK_MASK >> SE_PALBANK_SHIFT) |
+            ((SE_PALBANK_MASK >> SE_PALBANK_SHIFT) << 16);
+
+    [[nodiscard]] inline unsigned _offset_cells(unsigned cells, unsigned tiles_offsets, unsigned palette_offsets)
+    {
+        // Fields are added in both cells at once, since their sums don't overflow into the next cell:
+        unsigned tile_ids = ((cells & tile_ids_mask) + tiles_offsets) & tile_ids_mask;
+        unsigned palette_banks = (((cells >> SE_PALBANK_SHIFT) & palette_banks_mask) + palette_offsets) &
+                palette_banks_mask;
+        return tile_ids | (cells & flips_mask) | (palette_banks << SE_PALBANK_SHIFT);
+    }
+
+    [[nodiscard]] inline unsigned _tiles_offsets(unsigned tiles_offset)
+    {
+        return (tiles_offset & SE_ID_MASK) * 0x00010001;
+    }
+
+    [[nodiscard]] inline unsigned _palette_offsets(unsigned palette_offset)
+    {
+        return (palette_offset & (SE_PALBANK_MASK >> SE_PALBANK_SHIFT)) * 0x00010001;
+    }
+}
+
+void copy_regular_bg_map_cells_offset(const uint16_t* source_cells_ptr, int cells_count, unsigned tiles_offset,
+                                      unsigned palette_offset, uint16_t* destination_cells_ptr)
+{
+    unsigned tiles_offsets = _tiles_offsets(tiles_offset);
+    unsigned palette_offsets = _palette_offsets(palette_offset);
+
+    // Destination cells are written in 32-bit words, so the first one is copied alone if it is not word aligned:
+    if(cells_count && (reinterpret_cast<uintptr_t>(destination_cells_ptr) & 2))
+    {
+        *destination_cells_ptr = uint16_t(_offset_cells(*source_cells_ptr, tiles_offsets, palette_offsets));
+        ++source_cells_ptr;
+        ++destination_cells_ptr;
+        --cells_count;
+    }
+
+    auto destination_words_ptr = reinterpret_cast<unsigned*>(destination_cells_ptr);
+    int words_count = cells_count / 2;
+
+    if(reinterpret_cast<uintptr_t>(source_cells_ptr) & 2)
+    {
+        // Source cells are not word aligned, so they are read one by one:
+        for(int index = 0; index < words_count; ++index)
+        {
+            unsigned cells = source_cells_ptr[0] | (unsigned(source_cells_ptr[1]) << 16);
+            destination_words_ptr[index] = _offset_cells(cells, tiles_offsets, palette_offsets);
+            source_cells_ptr += 2;
+        }
+    }
+    else
+    {
+        auto source_words_ptr = reinterpret_cast<const unsigned*>(source_cells_ptr);
+
+        for(int index = 0; index < words_count; ++index)
+        {
+            destination_words_ptr[index] = _offset_cells(source_words_ptr[index], tiles_offsets, palette_offsets);
+        }
+
+        source_cells_ptr += words_count * 2;
+    }
+
+    if(cells_count & 1)
+    {
+        destination_cells_ptr += words_count * 2;
+        *destination_cells_ptr = uint16_t(_offset_cells(*source_cells_ptr, tiles_offsets, palette_offsets));
+    }
+}
+
+void copy_regular_bg_map_col_offset(const uint16_t* source_cells_ptr, int source_stride, int cells_count,
+                                    unsigned tiles_offset, unsigned palette_offset, uint16_t* destination_cells_ptr)
+{
+    unsigned tiles_offsets = _tiles_offsets(tiles_offset);
+    unsigned palette_offsets = _palette_offsets(palette_offset);
+
+    for(int pairs_count = cells_count / 2; pairs_count; --pairs_count)
+    {
+        unsigned cells = source_cells_ptr[0] | (unsigned(source_cells_ptr[source_stride]) << 16);
+        cells = _offset_cells(cells, tiles_offsets, palette_offsets);
+        destination_cells_ptr[0] = uint16_t(cells);
+        destination_cells_ptr[32] = uint16_t(cells >> 16);
+        source_cells_ptr += source_stride * 2;
+        destination_cells_ptr += 64;
+    }
+
+    if(cells_count & 1)
+    {
+        *destination_cells_ptr = uint16_t(_offset_cells(*source_cells_ptr, tiles_offsets, palette_offsets));
+    }
+}
+
+}
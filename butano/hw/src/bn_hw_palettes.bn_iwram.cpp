@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2020 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "../include/bn_hw_palettes.h"
+
+namespace bn::hw::palettes
+{
+
+namespace
+{
+    // Red and blue of the first color and green of the second one (-g-|b-r), as in clr_blend_fast:
+    constexpr unsigned channels_mask = 0x03E07C1F;
+    constexpr unsigned channels_round = 0x00200401 * 16;
+
+    [[nodiscard]] inline unsigned _ror_16(unsigned value)
+    {
+        return (value >> 16) | (value << 16);
+    }
+
+    [[nodiscard]] inline unsigned _blend_channels(unsigned a, unsigned b, unsigned weight)
+    {
+        // Channels are 10 bits apart, so weighted sums (up to 31 * 32 + 16) don't overflow into the next channel:
+        return (((a & channels_mask) * (32 - weight) + (b & channels_mask) * weight + channels_round) >> 5) &
+                channels_mask;
+    }
+
+    [[nodiscard]] inline unsigned _blend_colors(unsigned a, unsigned b, unsigned weight)
+    {
+        unsigned result = _blend_channels(a, b, weight);
+        return result | _ror_16(_blend_channels(_ror_16(a), _ror_16(b), weight));
+    }
+
+    [[nodiscard]] inline unsigned _gray(unsigned color_data)
+    {
+        unsigned red = (color_data & 31) * 0x4C;
+        unsigned green = ((color_data >> 5) & 31) * 0x96;
+        unsigned blue = ((color_data >> 10) & 31) * 0x1E;
+        return (red + green + blue + 0x80) >> 8;
+    }
+}
+
+void apply_channels_lut(const uint8_t* channels_lut, int count, color* colors_ptr)
+{
+    auto words_ptr = reinterpret_cast<unsigned*>(colors_ptr);
+
+    for(int index = 0, limit = count / 2; index < limit; ++index)
+    {
+        unsigned colors = words_ptr[index];
+        words_ptr[index] = channels_lut[colors & 31] |
+                (unsigned(channels_lut[(colors >> 5) & 31]) << 5) |
+                (unsigned(channels_lut[(colors >> 10) & 31]) << 10) |
+                (unsigned(channels_lut[(colors >> 16) & 31]) << 16) |
+                (unsigned(channels_lut[(colors >> 21) & 31]) << 21) |
+                (unsigned(channels_lut[(colors >> 26) & 31]) << 26);
+    }
+
+    if(count & 1)
+    {
+        auto last_color_ptr = reinterpret_cast<uint16_t*>(colors_ptr + count - 1);
+        unsigned last_color = *last_color_ptr;
+        *last_color_ptr = uint16_t(channels_lut[last_color & 31] |
+                (unsigned(channels_lut[(last_color >> 5) & 31]) << 5) |
+                (unsigned(channels_lut[(last_color >> 10) & 31]) << 10));
+    }
+}
+
+void grayscale(int intensity, int count, color* colors_ptr)
+{
+    auto words_ptr = reinterpret_cast<unsigned*>(colors_ptr);
+    auto weight = unsigned(intensity);
+
+    for(int index = 0, limit = count / 2; index < limit; ++index)
+    {
+        unsigned colors = words_ptr[index];
+        unsigned grays = (_gray(colors) | (_gray(colors >> 16) << 16)) * 0x0421;
+        words_ptr[index] = _blend_colors(colors, grays, weight);
+    }
+
+    if(count & 1)
+    {
+        auto last_color_ptr = reinterpret_cast<uint16_t*>(colors_ptr + count - 1);
+        unsigned last_color = *last_color_ptr;
+        *last_color_ptr = uint16_t(_blend_colors(last_color, _gray(last_color) * 0x0421, weight));
+    }
+}
+
+}
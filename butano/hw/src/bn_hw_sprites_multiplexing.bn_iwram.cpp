@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2020 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "../include/bn_hw_sprites_multiplexing.h"
+
+#if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+
+namespace bn::hw::sprites_multiplexing
+{
+
+namespace
+{
+    class static_data
+    {
+
+    public:
+        const bands* bands_ptr = nullptr;
+    };
+
+    static_data data;
+}
+
+void commit_bands(const bands& bands_ref)
+{
+    data.bands_ptr = &bands_ref;
+}
+
+void _intr()
+{
+    int vcount = REG_VCOUNT;
+
+    if(vcount >= display::height())
+    {
+        return;
+    }
+
+    int band = bands_count() - 1;
+
+    while(band > 0 && vcount < band_vcount(band))
+    {
+        --band;
+    }
+
+    if(! band)
+    {
+        return;
+    }
+
+    const band_entries& band_entries_ref = data.bands_ptr->items[band - 1];
+    const entry* entries = band_entries_ref.entries;
+    sprites::handle_type* oam = sprites::vram();
+
+    for(int index = 0, limit = band_entries_ref.entries_count; index < limit; ++index)
+    {
+        const entry& entry_ref = entries[index];
+        sprites::handle_type& handle = oam[entry_ref.index];
+        handle.attr1 = entry_ref.attr1;
+        handle.attr2 = entry_ref.attr2;
+        handle.attr0 = entry_ref.attr0;
+    }
+
+    int next_band = band + 1 < bands_count() ? band + 1 : 1;
+    REG_DISPSTAT = uint16_t((REG_DISPSTAT & ~DSTAT_VCT_MASK) | DSTAT_VCT(band_vcount(next_band)));
+}
+
+}
+
+#endif
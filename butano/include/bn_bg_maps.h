@@ -43,6 +43,43 @@ namespace bn::bg_maps
      */
     [[nodiscard]] int available_blocks_count();
 
+    /**
+     * @brief Returns the number of bytes of background map cells which don't fit in the next V-Blank upload budget.
+     *
+     * It is always 0 if BN_CFG_BG_BLOCKS_MAX_COMMIT_BYTES is 0.
+     */
+    [[nodiscard]] int queued_bytes();
+
+    /**
+     * @brief Returns the number of blocks of the biggest block of contiguous available background blocks.
+     *
+     * Creating background tiles or maps with more blocks than this value fails,
+     * even if there's enough available blocks.
+     */
+    [[nodiscard]] int available_contiguous_blocks_count();
+
+    /**
+     * @brief Starts moving used background tiles and maps to close the gaps between them.
+     *
+     * Background tiles are moved to the beginning of VRAM and background maps to the end,
+     * so gaps are merged between them without breaking the tiles charblocks alignment.
+     *
+     * Tiles and maps are relocated incrementally in the next V-Blanks,
+     * up to @a BN_CFG_BG_BLOCKS_COMPACTION_MAX_BLOCKS blocks in each one.
+     *
+     * Only tiles and maps with a source data reference are relocated:
+     * allocated tiles and maps are kept in place, since their VRAM can be referenced by the user.
+     *
+     * The backgrounds which use relocated tiles or maps are updated in the same V-Blank,
+     * but the values of background attributes H-Blank effects must be reloaded.
+     */
+    void compact();
+
+    /**
+     * @brief Indicates if background tiles and maps are being compacted or not.
+     */
+    [[nodiscard]] bool compacting();
+
     #if BN_CFG_LOG_ENABLED || BN_DOXYGEN
         /**
          * @brief Logs the current status of the background blocks manager.
@@ -13,6 +13,7 @@
  * @ingroup bg
  */
 
+#include "bn_big_map_redraw_mode.h"
 #include "../hw/include/bn_hw_bgs_constants.h"
 
 /**
@@ -36,6 +37,30 @@ namespace bn::bgs
      */
     [[nodiscard]] int available_items_count();
 
+    /**
+     * @brief Returns how the visible area of big maps is redrawn when they move more than 8 cells in a frame.
+     */
+    [[nodiscard]] big_map_redraw_mode big_maps_redraw_mode();
+
+    /**
+     * @brief Sets how the visible area of big maps is redrawn when they move more than 8 cells in a frame.
+     *
+     * Redraws in progress are completed in the next V-Blank if the new mode is big_map_redraw_mode::IMMEDIATE.
+     */
+    void set_big_maps_redraw_mode(big_map_redraw_mode redraw_mode);
+
+    /**
+     * @brief Indicates if the visible area of any big map is being redrawn over several V-Blanks or not.
+     *
+     * It can be used to hold a fade or a transition until the new area is visible.
+     */
+    [[nodiscard]] bool big_maps_redrawing();
+
+    /**
+     * @brief Returns the number of big map rows which have not been redrawn yet.
+     */
+    [[nodiscard]] int big_maps_redraw_pending_rows();
+
     /**
      * @return Returns the minimum priority of a background relative to sprites and other backgrounds.
      */
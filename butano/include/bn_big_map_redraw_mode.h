@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2020 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_BIG_MAP_REDRAW_MODE_H
+#define BN_BIG_MAP_REDRAW_MODE_H
+
+/**
+ * @file
+ * bn::big_map_redraw_mode header file.
+ *
+ * @ingroup bg
+ */
+
+#include "bn_common.h"
+
+namespace bn
+{
+
+/**
+ * @brief Specifies how the visible area of a big map is redrawn
+ * when it moves more than 8 cells in a frame (teleports, room transitions, etc).
+ *
+ * @ingroup bg
+ */
+enum class big_map_redraw_mode
+{
+    IMMEDIATE, //!< The visible area is redrawn in one V-Blank.
+    PROGRESSIVE, //!< The visible area is redrawn over several V-Blanks (see BN_CFG_BGS_BIG_MAPS_REDRAW_ROWS).
+    PROGRESSIVE_HIDDEN //!< Like PROGRESSIVE, but the background is hidden until the redraw is complete.
+};
+
+}
+
+#endif
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2020 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_COMPRESSION_TYPE_H
+#define BN_COMPRESSION_TYPE_H
+
+/**
+ * @file
+ * bn::compression_type header file.
+ *
+ * @ingroup tile
+ */
+
+#include "bn_common.h"
+
+namespace bn
+{
+
+/**
+ * @brief Specifies the available compression formats for tiles.
+ *
+ * Compressed tiles are decompressed with the GBA BIOS routines straight into VRAM when they are committed.
+ *
+ * Relative commit costs, from the cheapest to the most expensive per decompressed byte:
+ * NONE (DMA-like copy), RUN_LENGTH, LZ77 and HUFFMAN.
+ *
+ * @ingroup tile
+ */
+enum class compression_type
+{
+    NONE, //!< Uncompressed data.
+    LZ77, //!< GBA BIOS compatible LZ77 compressed data (VRAM safe).
+    RUN_LENGTH, //!< GBA BIOS compatible run-length compressed data.
+    HUFFMAN //!< GBA BIOS compatible 4 bits Huffman compressed data.
+};
+
+}
+
+#endif
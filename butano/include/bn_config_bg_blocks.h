@@ -26,6 +26,80 @@
     #define BN_CFG_BG_BLOCKS_MAX_ITEMS 16
 #endif
 
+/**
+ * @def BN_CFG_BG_BLOCKS_MAX_COMMIT_BYTES
+ *
+ * Specifies the maximum number of bytes of background tiles and maps that can be uploaded to VRAM in each V-Blank,
+ * or 0 to upload all pending background tiles and maps in the same V-Blank.
+ *
+ * Background tiles and maps which don't fit in this budget are queued and uploaded in the next V-Blanks.
+ * Backgrounds which use new tiles or maps are hidden until they are uploaded.
+ *
+ * Tiles and maps which are already in VRAM are uploaded before new ones,
+ * and at least one tile set or map is uploaded in each V-Blank, even if it doesn't fit in this budget.
+ *
+ * Big maps are not affected by this budget.
+ *
+ * @ingroup bg
+ */
+#ifndef BN_CFG_BG_BLOCKS_MAX_COMMIT_BYTES
+    #define BN_CFG_BG_BLOCKS_MAX_COMMIT_BYTES 0
+#endif
+
+/**
+ * @def BN_CFG_BG_BLOCKS_MAX_TILES_CACHES
+ *
+ * Specifies the maximum number of big regular background maps with a tiles cache
+ * (see regular_bg_map_ptr::create_new_with_tiles_cache) that can be created.
+ *
+ * Each tiles cache needs 4KB of EWRAM plus 8 bytes per tile (see BN_CFG_BG_BLOCKS_TILES_CACHE_MAX_TILES).
+ *
+ * @ingroup bg
+ */
+#ifndef BN_CFG_BG_BLOCKS_MAX_TILES_CACHES
+    #define BN_CFG_BG_BLOCKS_MAX_TILES_CACHES 0
+#endif
+
+/**
+ * @def BN_CFG_BG_BLOCKS_TILES_CACHE_MAX_TILES
+ *
+ * Specifies the maximum number of tiles that can be cached in VRAM by each tiles cache.
+ *
+ * @ingroup bg
+ */
+#ifndef BN_CFG_BG_BLOCKS_TILES_CACHE_MAX_TILES
+    #define BN_CFG_BG_BLOCKS_TILES_CACHE_MAX_TILES 512
+#endif
+
+/**
+ * @def BN_CFG_BG_BLOCKS_COMPACTION_MAX_BLOCKS
+ *
+ * Specifies the maximum number of background blocks that can be relocated in each V-Blank
+ * when background tiles and maps are being compacted.
+ *
+ * At least one tile set or map is relocated in each V-Blank, even if it doesn't fit in this budget.
+ *
+ * @ingroup bg
+ */
+#ifndef BN_CFG_BG_BLOCKS_COMPACTION_MAX_BLOCKS
+    #define BN_CFG_BG_BLOCKS_COMPACTION_MAX_BLOCKS 4
+#endif
+
+/**
+ * @def BN_CFG_BG_BLOCKS_COMPACTION_THRESHOLD
+ *
+ * Specifies the number of blocks of the biggest block of contiguous available background blocks
+ * below which background tiles and maps are compacted automatically,
+ * or 0 to compact them only with bn::bg_tiles::compact or bn::bg_maps::compact.
+ *
+ * Background tiles and maps are not compacted automatically if there's less available blocks than this threshold.
+ *
+ * @ingroup bg
+ */
+#ifndef BN_CFG_BG_BLOCKS_COMPACTION_THRESHOLD
+    #define BN_CFG_BG_BLOCKS_COMPACTION_THRESHOLD 0
+#endif
+
 /**
  * @def BN_CFG_BG_BLOCKS_LOG_ENABLED
  *
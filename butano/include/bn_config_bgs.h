@@ -28,4 +28,18 @@
     #define BN_CFG_BGS_MAX_ITEMS 4
 #endif
 
+/**
+ * @def BN_CFG_BGS_BIG_MAPS_REDRAW_ROWS
+ *
+ * Specifies the maximum number of map rows redrawn in each V-Blank by a big map
+ * with big_map_redraw_mode::PROGRESSIVE or big_map_redraw_mode::PROGRESSIVE_HIDDEN redraw modes.
+ *
+ * The visible area of a big map has 22 rows.
+ *
+ * @ingroup bg
+ */
+#ifndef BN_CFG_BGS_BIG_MAPS_REDRAW_ROWS
+    #define BN_CFG_BGS_BIG_MAPS_REDRAW_ROWS 6
+#endif
+
 #endif
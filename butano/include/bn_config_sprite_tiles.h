@@ -27,6 +27,52 @@
     #define BN_CFG_SPRITE_TILES_MAX_ITEMS 128
 #endif
 
+/**
+ * @def BN_CFG_SPRITE_TILES_MAX_COMMIT_BYTES
+ *
+ * Specifies the maximum number of bytes of sprite tiles that can be uploaded to VRAM in each V-Blank,
+ * or 0 to upload all pending sprite tiles in the same V-Blank.
+ *
+ * Sprite tiles which don't fit in this budget are queued and uploaded in the next V-Blanks.
+ * Sprites which use new tiles are hidden until their tiles are uploaded.
+ *
+ * Tiles which are already in VRAM (animation frames, for example) are uploaded before new ones,
+ * and at least one tile set is uploaded in each V-Blank, even if it doesn't fit in this budget.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITE_TILES_MAX_COMMIT_BYTES
+    #define BN_CFG_SPRITE_TILES_MAX_COMMIT_BYTES 0
+#endif
+
+/**
+ * @def BN_CFG_SPRITE_TILES_COMPACTION_MAX_TILES
+ *
+ * Specifies the maximum number of sprite tiles that can be relocated in each V-Blank
+ * when sprite tiles are being compacted.
+ *
+ * At least one tile set is relocated in each V-Blank, even if it doesn't fit in this budget.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITE_TILES_COMPACTION_MAX_TILES
+    #define BN_CFG_SPRITE_TILES_COMPACTION_MAX_TILES 64
+#endif
+
+/**
+ * @def BN_CFG_SPRITE_TILES_COMPACTION_THRESHOLD
+ *
+ * Specifies the number of tiles of the biggest block of contiguous available sprite tiles
+ * below which sprite tiles are compacted automatically, or 0 to compact them only with bn::sprite_tiles::compact.
+ *
+ * Sprite tiles are not compacted automatically if there's less available tiles than this threshold.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITE_TILES_COMPACTION_THRESHOLD
+    #define BN_CFG_SPRITE_TILES_COMPACTION_THRESHOLD 0
+#endif
+
 /**
  * @def BN_CFG_SPRITE_TILES_LOG_ENABLED
  *
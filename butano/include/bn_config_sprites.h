@@ -37,10 +37,108 @@
  * Sprites are grouped in layers depending of their background priority and z order,
  * so to reduce memory usage and improve performance, please use as less unique z orders as possible.
  *
+ * It is ignored if BN_CFG_SPRITES_BATCHED_SORT_ENABLED is true.
+ *
  * @ingroup sprite
  */
 #ifndef BN_CFG_SPRITES_MAX_SORT_LAYERS
     #define BN_CFG_SPRITES_MAX_SORT_LAYERS 16
 #endif
 
+/**
+ * @def BN_CFG_SPRITES_BATCHED_SORT_ENABLED
+ *
+ * Specifies if sprites must be sorted once per frame instead of every time their sort key changes.
+ *
+ * When it is enabled, sprites are stored in a flat array which is sorted with a radix sort
+ * only in the frames in which a sprite has been created, removed or its background priority or z order has changed.
+ *
+ * It removes the BN_CFG_SPRITES_MAX_SORT_LAYERS limit and it's faster when many sprites change their z order
+ * in the same frame (for example, when they are sorted by their vertical position),
+ * but it's slower than the default mode when only a few of them change.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_BATCHED_SORT_ENABLED
+    #define BN_CFG_SPRITES_BATCHED_SORT_ENABLED false
+#endif
+
+/**
+ * @def BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+ *
+ * Specifies if sprite multiplexing must be enabled or not.
+ *
+ * When it is enabled, the screen is split in horizontal bands and OAM entries of sprites which are not displayed
+ * anymore are overwritten mid-frame with the sprites of the next band,
+ * so more than 128 sprites can be displayed at the same time as long as there's no more than 128 sprites per band.
+ *
+ * Sprites which can't be placed are not displayed instead of raising an error.
+ *
+ * Sprite H-Blank effects are not supported for sprites which don't start in the first band.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+    #define BN_CFG_SPRITES_MULTIPLEXING_ENABLED false
+#endif
+
+/**
+ * @def BN_CFG_SPRITES_MULTIPLEXING_BANDS
+ *
+ * Specifies the number of horizontal screen bands used by sprite multiplexing (valid range is [2..8]).
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_MULTIPLEXING_BANDS
+    #define BN_CFG_SPRITES_MULTIPLEXING_BANDS 4
+#endif
+
+/**
+ * @def BN_CFG_SPRITES_MAX_PARTICLE_HANDLES
+ *
+ * Specifies the maximum number of OAM entries that can be used by bn::sprite_particle_emitter objects in each frame.
+ *
+ * Particles only use the OAM entries which are not used by the visible sprites.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_MAX_PARTICLE_HANDLES
+    #define BN_CFG_SPRITES_MAX_PARTICLE_HANDLES 64
+#endif
+
+/**
+ * @def BN_CFG_SPRITES_SCANLINE_CYCLES_ENABLED
+ *
+ * Specifies if the OBJ rendering cycles spent by the visible sprites in each scanline must be estimated or not.
+ *
+ * When a scanline needs more cycles than the GBA provides, the last sprites of that scanline are not displayed.
+ * If this estimation is enabled, the cycles spent in each scanline can be retrieved
+ * and sprites flicker mode can be enabled to alternate which sprites are dropped each frame.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_SCANLINE_CYCLES_ENABLED
+    #define BN_CFG_SPRITES_SCANLINE_CYCLES_ENABLED false
+#endif
+
+/**
+ * @def BN_CFG_SPRITES_AFFINE_MATS_INTERNING_ENABLED
+ *
+ * Specifies if the sprite affine mats created by bn::sprite_ptr rotation and scale setters must be shared
+ * between sprites with the same GBA register values or not.
+ *
+ * When it is enabled, sprites which are rotated or scaled without an explicit bn::sprite_affine_mat_ptr
+ * use a sprite affine mat shared with the other sprites with the same affine transformation,
+ * so more than 32 sprites can be rotated or scaled at the same time as long as there's no more than
+ * 32 unique affine transformations.
+ *
+ * Modifying a shared sprite affine mat with bn::sprite_ptr::affine_mat stops sharing it with new sprites,
+ * but all sprites which are using it are modified too.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_AFFINE_MATS_INTERNING_ENABLED
+    #define BN_CFG_SPRITES_AFFINE_MATS_INTERNING_ENABLED false
+#endif
+
 #endif
@@ -927,6 +927,12 @@
  * * `"type"`: must be `"sprite"` for sprites.
  * * `"height"`: height of each sprite image in pixels.
  * For example, if the specified height is 32, an image with 128 pixels of height contains 4 sprite images.
+ * * `"compression"`: optional field which specifies the compression of the sprite tiles:
+ * `"none"`, `"lz77"`, `"run_length"`, `"huffman"` or `"auto"` (the smallest one is selected).
+ * Compressed tiles are decompressed with the GBA BIOS routines straight into VRAM when they are committed,
+ * so they use less ROM but take more time to be uploaded. `"none"` by default.
+ * * `"delta_animation"`: optional field which specifies if a bn::sprite_tiles_delta_item must be generated too,
+ * so the sprite images can be streamed with a bn::sprite_delta_animate_action. `false` by default.
  *
  * If the conversion process has finished successfully,
  * a bn::sprite_item should have been generated in the `build` folder.
@@ -985,6 +991,20 @@
  * Butano expects that the image color palette is already valid for this mode.
  *
  * The default is `"bpp_4_manual"` for 16 color images and `"bpp_8"` for 256 color images.
+ * * `"tiles_group"`: optional field which specifies the name of a tiles group.
+ * Regular backgrounds with the same tiles group share the same @ref tile "tiles",
+ * so repeated tiles (and flipped tiles if `"flipped_tiles_reduction"` is enabled) are stored only once
+ * and are uploaded to VRAM only once if the regular backgrounds are displayed at the same time.
+ * All regular backgrounds of a tiles group must have the same bits per pixel.
+ * A bn::regular_bg_tiles_item with the name of the tiles group is generated too.
+ * * `"column_major_map"`: optional field which specifies if a copy of the map cells stored column by column
+ * must be generated too. Big maps read the cells of each column from it in one go when they are scrolled
+ * horizontally, but it doubles the map size.
+ * `false` by default.
+ * * `"metatile_size"`: optional field which specifies the size in pixels of the metatiles of big maps
+ * (`16` or `32`). If it is specified, the map is split in square blocks of this size,
+ * equal blocks are stored only once and they are expanded on the fly when the map is scrolled.
+ * It can't be used with `"column_major_map"`.
  *
  * If the conversion process has finished successfully,
  * a bn::regular_bg_item should have been generated in the `build` folder.
@@ -1086,6 +1106,54 @@
  * @tableofcontents
  *
  *
+ * @section changelog_4_4_0 4.4.0
+ *
+ * * Sprite multiplexing support: more than 128 sprites can be displayed at the same time
+ *   if @a BN_CFG_SPRITES_MULTIPLEXING_ENABLED is overloaded to true.
+ * * Batched sprite sorting: sprites can be sorted with a radix sort once per frame
+ *   if @a BN_CFG_SPRITES_BATCHED_SORT_ENABLED is overloaded to true.
+ * * Sprite batch functions added: bn::sprites::set_positions, bn::sprites::set_z_orders,
+ *   bn::sprites::set_horizontal_flips and bn::sprites::set_vertical_flips.
+ * * Sprites OAM commit range is prepared before V-Blank and pushed with DMA at the start of V-Blank.
+ * * Lightweight sprite particles added: bn::sprite_particle_emitter.
+ * * Sprites OBJ rendering cycles per scanline can be estimated and sprites flicker mode can be enabled
+ *   if @a BN_CFG_SPRITES_SCANLINE_CYCLES_ENABLED is overloaded to true.
+ * * Sprites with the same affine transformation can share the same sprite affine mat
+ *   if @a BN_CFG_SPRITES_AFFINE_MATS_INTERNING_ENABLED is overloaded to true.
+ * * V-Blank VRAM upload budgets added: @a BN_CFG_SPRITE_TILES_MAX_COMMIT_BYTES and
+ *   @a BN_CFG_BG_BLOCKS_MAX_COMMIT_BYTES.
+ * * bn::sprite_tiles::queued_bytes, bn::bg_tiles::queued_bytes and bn::bg_maps::queued_bytes added.
+ * * Sprite tiles can be compressed with LZ77, run-length or Huffman encoding (bn::compression_type).
+ * * Sprite tiles free blocks lookup is O(1) with segregated free lists indexed by a bitmap.
+ * * Sprite tiles can be compacted incrementally in the next V-Blanks with bn::sprite_tiles::compact,
+ *   or automatically with @a BN_CFG_SPRITE_TILES_COMPACTION_THRESHOLD.
+ * * Large animated sprites can be streamed to VRAM uploading only the tiles which change between frames
+ *   (bn::sprite_delta_animate_action).
+ * * Regular backgrounds can share their tiles with the `"tiles_group"` field of their `*.json` files.
+ * * Graphics files are processed in parallel, and assets are rebuilt only if their content has changed
+ *   (switching branches doesn't rebuild them anymore).
+ * * Graphics data is stored in binary files included by the generated assembly files,
+ *   unless the `--no-binaries` option of the graphics tool is used.
+ * * Big regular BG maps columns can be read from a column-major copy of the map cells
+ *   (bn::regular_bg_map_item::column_major_cells_ptr).
+ * * Big maps visible area can be redrawn over several V-Blanks after large camera jumps
+ *   (bn::bgs::set_big_maps_redraw_mode).
+ * * Big regular BG maps can be stored as metatiles with the `"metatile_size"` field of their `*.json` files.
+ * * Big regular BG maps can stream their tiles to a LRU cache in VRAM
+ *   (bn::regular_bg_map_ptr::create_new_with_tiles_cache).
+ * * Regular BG maps can upload only the modified cells to VRAM
+ *   (bn::regular_bg_map_ptr::reload_cells_ref(int, int, int, int)).
+ * * Regular BG map cells with tiles or palette offsets are copied two at a time with ARM code in IWRAM.
+ * * Background tiles and maps can be compacted incrementally in the next V-Blanks with bn::bg_tiles::compact,
+ *   or automatically when the biggest contiguous free area is smaller than
+ *   @a BN_CFG_BG_BLOCKS_COMPACTION_THRESHOLD blocks (disabled by default).
+ *   Up to @a BN_CFG_BG_BLOCKS_COMPACTION_MAX_BLOCKS blocks are relocated in each V-Blank.
+ *   Backgrounds which use relocated tiles or maps are updated automatically,
+ *   but the values of background attributes H-Blank effects must be reloaded.
+ * * Palettes brightness, contrast, intensity and inversion are applied at once with a cached lookup table,
+ *   and palettes grayscale is applied with ARM code in IWRAM.
+ *
+ *
  * @section changelog_4_3_0 4.3.0
  *
  * * H-Blank effects EWRAM usage reduced (more than 2KB by default).
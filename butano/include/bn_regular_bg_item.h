@@ -137,6 +137,28 @@ public:
      */
     [[nodiscard]] optional<regular_bg_ptr> create_bg_optional(const fixed_point& position) const;
 
+    /**
+     * @brief Creates a regular_bg_ptr using the information contained in this item,
+     * streaming its tiles to a cache of allocated tiles in VRAM
+     * (see regular_bg_map_ptr::create_new_with_tiles_cache).
+     * @param x Horizontal position of the regular background.
+     * @param y Vertical position of the regular background.
+     * @param cache_tiles_count Number of tiles to allocate for the cache.
+     * @return The requested regular_bg_ptr.
+     */
+    [[nodiscard]] regular_bg_ptr create_bg_with_tiles_cache(fixed x, fixed y, int cache_tiles_count) const;
+
+    /**
+     * @brief Creates a regular_bg_ptr using the information contained in this item,
+     * streaming its tiles to a cache of allocated tiles in VRAM
+     * (see regular_bg_map_ptr::create_new_with_tiles_cache).
+     * @param position Position of the regular background.
+     * @param cache_tiles_count Number of tiles to allocate for the cache.
+     * @return The requested regular_bg_ptr.
+     */
+    [[nodiscard]] regular_bg_ptr create_bg_with_tiles_cache(const fixed_point& position,
+                                                            int cache_tiles_count) const;
+
     /**
      * @brief Searches for a regular_bg_map_ptr which references the information provided by this item.
      * @return regular_bg_map_ptr which references the information provided by this item if it has been found;
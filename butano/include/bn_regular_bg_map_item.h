@@ -62,14 +62,99 @@ public:
                   "Invalid height: ", dimensions.height());
     }
 
+    /**
+     * @brief Constructor.
+     * @param cells_ref Reference to one or more regular background map cells.
+     *
+     * The map cells are not copied but referenced, so they should outlive the regular_bg_map_item
+     * to avoid dangling references.
+     *
+     * @param column_major_cells_ref Reference to a copy of the map cells stored column by column.
+     *
+     * The cells of each column of big maps are read from it in one go when they are scrolled horizontally.
+     *
+     * @param dimensions Size in map cells of the referenced map cells.
+     */
+    constexpr regular_bg_map_item(const regular_bg_map_cell& cells_ref,
+                                  const regular_bg_map_cell& column_major_cells_ref, const size& dimensions) :
+        _cells_ptr(&cells_ref),
+        _column_major_cells_ptr(&column_major_cells_ref),
+        _dimensions(dimensions)
+    {
+        BN_ASSERT(dimensions.width() >= 32 && dimensions.width() % 32 == 0,
+                  "Invalid width: ", dimensions.width());
+        BN_ASSERT(dimensions.height() >= 32 && dimensions.height() % 32 == 0,
+                  "Invalid height: ", dimensions.height());
+    }
+
+    /**
+     * @brief Constructor.
+     * @param metatile_indexes_ref Reference to the index of the metatile of each block of the map.
+     *
+     * The metatile indexes are not copied but referenced, so they should outlive the regular_bg_map_item
+     * to avoid dangling references.
+     *
+     * @param metatiles_cells_ref Reference to the cells of all metatiles, stored metatile by metatile.
+     *
+     * The cells of each metatile are stored row by row.
+     *
+     * @param metatile_size Width and height in map cells of each metatile (2 or 4).
+     * @param dimensions Size in map cells of the map.
+     *
+     * Metatiles are only supported by big maps, since they are expanded on the fly when the map is scrolled.
+     */
+    constexpr regular_bg_map_item(const uint16_t& metatile_indexes_ref,
+                                  const regular_bg_map_cell& metatiles_cells_ref, int metatile_size,
+                                  const size& dimensions) :
+        _cells_ptr(&metatile_indexes_ref),
+        _metatiles_cells_ptr(&metatiles_cells_ref),
+        _metatile_size(int8_t(metatile_size)),
+        _dimensions(dimensions)
+    {
+        BN_ASSERT(metatile_size == 2 || metatile_size == 4, "Invalid metatile size: ", metatile_size);
+        BN_ASSERT(dimensions.width() >= 32 && dimensions.width() % 32 == 0,
+                  "Invalid width: ", dimensions.width());
+        BN_ASSERT(dimensions.height() >= 32 && dimensions.height() % 32 == 0,
+                  "Invalid height: ", dimensions.height());
+        BN_ASSERT(dimensions.width() > 64 || dimensions.height() > 64,
+                  "Metatiles are only supported by big maps: ", dimensions.width(), " - ", dimensions.height());
+    }
+
     /**
      * @brief Returns the referenced map cells.
+     *
+     * If the map has metatiles, it returns the referenced metatile indexes instead.
      */
     [[nodiscard]] constexpr const regular_bg_map_cell& cells_ref() const
     {
         return *_cells_ptr;
     }
 
+    /**
+     * @brief Returns the referenced cells of all metatiles, or `nullptr` if the map has no metatiles.
+     */
+    [[nodiscard]] constexpr const regular_bg_map_cell* metatiles_cells_ptr() const
+    {
+        return _metatiles_cells_ptr;
+    }
+
+    /**
+     * @brief Returns the width and height in map cells of each metatile, or 1 if the map has no metatiles.
+     */
+    [[nodiscard]] constexpr int metatile_size() const
+    {
+        return _metatile_size;
+    }
+
+    /**
+     * @brief Returns the referenced copy of the map cells stored column by column,
+     * or `nullptr` if it was not provided.
+     */
+    [[nodiscard]] constexpr const regular_bg_map_cell* column_major_cells_ptr() const
+    {
+        return _column_major_cells_ptr;
+    }
+
     /**
      * @brief Returns the size in map cells of the referenced map cells.
      */
@@ -160,6 +245,9 @@ public:
 
 private:
     const regular_bg_map_cell* _cells_ptr;
+    const regular_bg_map_cell* _column_major_cells_ptr = nullptr;
+    const regular_bg_map_cell* _metatiles_cells_ptr = nullptr;
+    int8_t _metatile_size = 1;
     size _dimensions;
 };
 
@@ -128,6 +128,28 @@ public:
      */
     [[nodiscard]] static regular_bg_map_ptr create_new(const regular_bg_item& item);
 
+    /**
+     * @brief Creates a big regular_bg_map_ptr which streams the tiles of the given regular_bg_item
+     * to a cache of allocated tiles in VRAM.
+     *
+     * Only the tiles referenced by the map cells in VRAM are kept in the cache,
+     * and the least recently used tiles are replaced when new ones are needed,
+     * so the tiles of the given regular_bg_item can take more VRAM than the cache.
+     *
+     * The cache must be big enough to hold the tiles referenced by a 32x32 area of the map.
+     *
+     * Up to @a BN_CFG_BG_BLOCKS_MAX_TILES_CACHES maps with a tiles cache can be created.
+     *
+     * The map cells and the tiles are not copied but referenced,
+     * so they should outlive the regular_bg_map_ptr to avoid dangling references.
+     *
+     * @param item regular_bg_item which references the tiles, the color palette and the map cells to handle.
+     * @param cache_tiles_count Number of tiles to allocate for the cache.
+     * @return regular_bg_map_ptr which references the given information.
+     */
+    [[nodiscard]] static regular_bg_map_ptr create_new_with_tiles_cache(
+            const regular_bg_item& item, int cache_tiles_count);
+
     /**
      * @brief Creates a regular_bg_map_ptr which references a chunk of VRAM map cells not visible on the screen.
      * @param dimensions Size in map cells of the map to allocate.
@@ -289,6 +311,8 @@ public:
     /**
      * @brief Returns the referenced map cells unless it was created with allocate or allocate_optional.
      * In that case, it returns bn::nullopt.
+     *
+     * If the map has metatiles, it returns the referenced metatile indexes instead.
      */
     [[nodiscard]] optional<span<const regular_bg_map_cell>> cells_ref() const;
 
@@ -309,6 +333,19 @@ public:
      */
     void reload_cells_ref();
 
+    /**
+     * @brief Uploads a region of the referenced map cells to VRAM again to make visible the possible changes in it.
+     *
+     * Regions reloaded before the next V-Blank are merged into their bounding rectangle,
+     * so only the modified cells are uploaded instead of the whole map.
+     *
+     * @param x Horizontal position of the top-left cell of the region.
+     * @param y Vertical position of the top-left cell of the region.
+     * @param width Number of columns of the region.
+     * @param height Number of rows of the region.
+     */
+    void reload_cells_ref(int x, int y, int width, int height);
+
     /**
      * @brief Returns the referenced tiles.
      */
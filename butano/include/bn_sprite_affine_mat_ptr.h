@@ -18,6 +18,7 @@
 #include "bn_fixed_fwd.h"
 #include "bn_functional.h"
 #include "bn_optional_fwd.h"
+#include "bn_config_sprites.h"
 
 namespace bn
 {
@@ -65,6 +66,16 @@ public:
      */
     [[nodiscard]] static optional<sprite_affine_mat_ptr> create_optional(const affine_mat_attributes& attributes);
 
+    /// @cond DO_NOT_DOCUMENT
+
+    #if BN_CFG_SPRITES_AFFINE_MATS_INTERNING_ENABLED
+        [[nodiscard]] static sprite_affine_mat_ptr _create_interned(const affine_mat_attributes& attributes);
+
+        [[nodiscard]] bool _interned() const;
+    #endif
+
+    /// @endcond
+
     /**
      * @brief Copy constructor.
      * @param other sprite_affine_mat_ptr to copy.
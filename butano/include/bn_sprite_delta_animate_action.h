@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2020 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SPRITE_DELTA_ANIMATE_ACTION_H
+#define BN_SPRITE_DELTA_ANIMATE_ACTION_H
+
+/**
+ * @file
+ * bn::sprite_delta_animate_action header file.
+ *
+ * @ingroup sprite
+ * @ingroup tile
+ * @ingroup action
+ */
+
+#include "bn_sprite_ptr.h"
+#include "bn_sprite_tiles_ptr.h"
+#include "bn_sprite_tiles_delta_item.h"
+
+namespace bn
+{
+
+/**
+ * @brief Streams the animation frames of a sprite_ptr to VRAM when the action is updated a given number of times.
+ *
+ * Only the tiles which differ from the frame displayed two frames before are uploaded,
+ * and they are written in the sprite tile set which is not displayed,
+ * so it only needs two tile sets in VRAM, no matter how many frames the animation has.
+ *
+ * Frames are displayed in the same order as they are stored in the given sprite_tiles_delta_item.
+ *
+ * The action must not be updated more than once per frame.
+ *
+ * @ingroup sprite
+ * @ingroup tile
+ * @ingroup action
+ */
+class sprite_delta_animate_action
+{
+
+public:
+    /**
+     * @brief Generates a sprite_delta_animate_action which loops over the given animation frames only once.
+     * @param sprite sprite_ptr to copy.
+     * @param wait_updates Number of times the action must be updated before changing the tiles of the given sprite_ptr.
+     * @param delta_item Tiles which change between the animation frames.
+     * @return The requested sprite_delta_animate_action.
+     */
+    [[nodiscard]] static sprite_delta_animate_action once(
+            const sprite_ptr& sprite, int wait_updates, const sprite_tiles_delta_item& delta_item)
+    {
+        return sprite_delta_animate_action(sprite, wait_updates, delta_item, false);
+    }
+
+    /**
+     * @brief Generates a sprite_delta_animate_action which loops over the given animation frames only once.
+     * @param sprite sprite_ptr to move.
+     * @param wait_updates Number of times the action must be updated before changing the tiles of the given sprite_ptr.
+     * @param delta_item Tiles which change between the animation frames.
+     * @return The requested sprite_delta_animate_action.
+     */
+    [[nodiscard]] static sprite_delta_animate_action once(
+            sprite_ptr&& sprite, int wait_updates, const sprite_tiles_delta_item& delta_item)
+    {
+        return sprite_delta_animate_action(move(sprite), wait_updates, delta_item, false);
+    }
+
+    /**
+     * @brief Generates a sprite_delta_animate_action which loops over the given animation frames forever.
+     * @param sprite sprite_ptr to copy.
+     * @param wait_updates Number of times the action must be updated before changing the tiles of the given sprite_ptr.
+     * @param delta_item Tiles which change between the animation frames.
+     * @return The requested sprite_delta_animate_action.
+     */
+    [[nodiscard]] static sprite_delta_animate_action forever(
+            const sprite_ptr& sprite, int wait_updates, const sprite_tiles_delta_item& delta_item)
+    {
+        return sprite_delta_animate_action(sprite, wait_updates, delta_item, true);
+    }
+
+    /**
+     * @brief Generates a sprite_delta_animate_action which loops over the given animation frames forever.
+     * @param sprite sprite_ptr to move.
+     * @param wait_updates Number of times the action must be updated before changing the tiles of the given sprite_ptr.
+     * @param delta_item Tiles which change between the animation frames.
+     * @return The requested sprite_delta_animate_action.
+     */
+    [[nodiscard]] static sprite_delta_animate_action forever(
+            sprite_ptr&& sprite, int wait_updates, const sprite_tiles_delta_item& delta_item)
+    {
+        return sprite_delta_animate_action(move(sprite), wait_updates, delta_item, true);
+    }
+
+    /**
+     * @brief Uploads the next animation frame and shows it in the given sprite_ptr
+     * when the given amount of update calls are done.
+     */
+    void update();
+
+    /**
+     * @brief Indicates if the action must not be updated anymore.
+     */
+    [[nodiscard]] bool done() const
+    {
+        return _current_graphics_index == _delta_item.graphics_count();
+    }
+
+    /**
+     * @brief Returns the sprite_ptr to modify.
+     */
+    [[nodiscard]] const sprite_ptr& sprite() const
+    {
+        return _sprite;
+    }
+
+    /**
+     * @brief Returns the number of times the action must be updated before changing the tiles of the given sprite_ptr.
+     */
+    [[nodiscard]] int wait_updates() const
+    {
+        return _wait_updates;
+    }
+
+    /**
+     * @brief Returns the tiles which change between the animation frames.
+     */
+    [[nodiscard]] const sprite_tiles_delta_item& delta_item() const
+    {
+        return _delta_item;
+    }
+
+    /**
+     * @brief Indicates if the action can be updated forever or not.
+     */
+    [[nodiscard]] bool update_forever() const
+    {
+        return _forever;
+    }
+
+    /**
+     * @brief Returns the index of the next animation frame to display.
+     */
+    [[nodiscard]] int current_index() const
+    {
+        return _current_graphics_index;
+    }
+
+private:
+    sprite_ptr _sprite;
+    sprite_tiles_delta_item _delta_item;
+    sprite_tiles_ptr _even_tiles;
+    sprite_tiles_ptr _odd_tiles;
+    uint16_t _wait_updates;
+    uint16_t _current_graphics_index = 0;
+    uint16_t _current_wait_updates = 0;
+    bool _forever;
+    bool _looped = false;
+    bool _odd_step = false;
+
+    sprite_delta_animate_action(const sprite_ptr& sprite, int wait_updates, const sprite_tiles_delta_item& delta_item,
+                                bool forever);
+
+    sprite_delta_animate_action(sprite_ptr&& sprite, int wait_updates, const sprite_tiles_delta_item& delta_item,
+                                bool forever);
+
+    void _upload(int delta_index, sprite_tiles_ptr& tiles);
+};
+
+}
+
+#endif
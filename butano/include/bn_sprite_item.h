@@ -61,6 +61,32 @@ public:
     {
     }
 
+    /**
+     * @brief Constructor.
+     * @param shape_size Shape and size of the output sprites.
+     * @param tiles_ref Reference to one or more compressed sprite tile sets.
+     *
+     * Each tile set is a compressed data block, and all blocks must be padded to the same size.
+     *
+     * The tiles are not copied but referenced, so they should outlive the sprite_item to avoid dangling references.
+     *
+     * @param colors_ref Reference to an array of multiples of 16 colors.
+     *
+     * The colors are not copied but referenced, so they should outlive the sprite_item to avoid dangling references.
+     *
+     * @param bpp Bits per pixel of the output sprites.
+     * @param compression Compression type of tiles_ref.
+     * @param graphics_count Number of sprite tile sets contained in tiles_ref.
+     */
+    constexpr sprite_item(const sprite_shape_size& shape_size, const span<const tile>& tiles_ref,
+                          const span<const color>& colors_ref, bpp_mode bpp, compression_type compression,
+                          int graphics_count) :
+        sprite_item(shape_size, sprite_tiles_item(tiles_ref, bpp, compression, graphics_count,
+                                                  shape_size.tiles_count(bpp)),
+                    sprite_palette_item(colors_ref, bpp))
+    {
+    }
+
     /**
      * @brief Constructor.
      * @param shape_size Shape and size of the output sprites.
@@ -74,8 +100,7 @@ public:
         _palette_item(palette_item)
     {
         BN_ASSERT(tiles_item.bpp() == palette_item.bpp(), "Tiles and color palette BPP are different");
-        BN_ASSERT(tiles_item.tiles_ref().size() ==
-                  _shape_size.tiles_count(palette_item.bpp()) * tiles_item.graphics_count(),
+        BN_ASSERT(tiles_item.tiles_count_per_graphic() == _shape_size.tiles_count(palette_item.bpp()),
                   "Invalid shape or size");
     }
 
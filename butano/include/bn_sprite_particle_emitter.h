@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2020 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SPRITE_PARTICLE_EMITTER_H
+#define BN_SPRITE_PARTICLE_EMITTER_H
+
+/**
+ * @file
+ * bn::isprite_particle_emitter and bn::sprite_particle_emitter implementation header file.
+ *
+ * @ingroup sprite
+ */
+
+#include "bn_fixed_point.h"
+#include "bn_intrusive_list.h"
+#include "bn_config_sprites.h"
+#include "bn_sprite_tiles_ptr.h"
+#include "bn_sprite_palette_ptr.h"
+#include "bn_sprite_shape_size.h"
+
+namespace bn
+{
+
+class sprite_item;
+
+/**
+ * @brief Base class of bn::sprite_particle_emitter.
+ *
+ * Particles are not sprites: they don't have sprite_ptr handles, they are not sorted
+ * and they don't reference sprite tiles or palettes individually.
+ *
+ * Their position, velocity, remaining lifetime and animation frame are stored in packed arrays,
+ * and the OAM entries of the particles on screen are written in one pass before each V-Blank,
+ * after the OAM entries of the visible sprites.
+ *
+ * Particles are always drawn behind the sprites with the same background priority.
+ *
+ * @ingroup sprite
+ */
+class isprite_particle_emitter : public intrusive_list_node_type
+{
+
+public:
+    isprite_particle_emitter(const isprite_particle_emitter& other) = delete;
+
+    isprite_particle_emitter& operator=(const isprite_particle_emitter& other) = delete;
+
+    /**
+     * @brief Destructor.
+     */
+    ~isprite_particle_emitter();
+
+    /**
+     * @brief Returns the shape and size of the particles.
+     */
+    [[nodiscard]] const sprite_shape_size& shape_size() const
+    {
+        return _shape_size;
+    }
+
+    /**
+     * @brief Returns the sprite tiles shared by all particles.
+     */
+    [[nodiscard]] const sprite_tiles_ptr& tiles() const
+    {
+        return _tiles;
+    }
+
+    /**
+     * @brief Returns the sprite palette shared by all particles.
+     */
+    [[nodiscard]] const sprite_palette_ptr& palette() const
+    {
+        return _palette;
+    }
+
+    /**
+     * @brief Returns the number of animation frames contained in tiles().
+     */
+    [[nodiscard]] int frames_count() const
+    {
+        return _frames_count;
+    }
+
+    /**
+     * @brief Returns the number of alive particles.
+     */
+    [[nodiscard]] int size() const
+    {
+        return _size;
+    }
+
+    /**
+     * @brief Returns the maximum number of alive particles.
+     */
+    [[nodiscard]] int max_size() const
+    {
+        return _max_size;
+    }
+
+    /**
+     * @brief Indicates if there's no alive particles.
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return _size == 0;
+    }
+
+    /**
+     * @brief Indicates if no more particles can be emitted.
+     */
+    [[nodiscard]] bool full() const
+    {
+        return _size == _max_size;
+    }
+
+    /**
+     * @brief Returns the maximum number of OAM entries that this emitter can use in each frame.
+     */
+    [[nodiscard]] int max_handles() const
+    {
+        return _max_handles;
+    }
+
+    /**
+     * @brief Sets the maximum number of OAM entries that this emitter can use in each frame.
+     *
+     * Particles which don't fit in this budget are not displayed.
+     *
+     * @param max_handles Maximum number of OAM entries in the range [0..BN_CFG_SPRITES_MAX_PARTICLE_HANDLES].
+     */
+    void set_max_handles(int max_handles);
+
+    /**
+     * @brief Returns the priority of the particles relative to backgrounds.
+     */
+    [[nodiscard]] int bg_priority() const
+    {
+        return _bg_priority;
+    }
+
+    /**
+     * @brief Sets the priority of the particles relative to backgrounds.
+     *
+     * Particles are drawn behind the sprites with the same background priority.
+     *
+     * @param bg_priority Priority in the range [0..3].
+     */
+    void set_bg_priority(int bg_priority);
+
+    /**
+     * @brief Returns the velocity added to each particle in each update.
+     */
+    [[nodiscard]] const fixed_point& acceleration() const
+    {
+        return _acceleration;
+    }
+
+    /**
+     * @brief Sets the velocity added to each particle in each update.
+     */
+    void set_acceleration(const fixed_point& acceleration)
+    {
+        _acceleration = acceleration;
+    }
+
+    /**
+     * @brief Returns the number of times that update must be called to advance the animation frame of each particle.
+     */
+    [[nodiscard]] int frame_wait_updates() const
+    {
+        return _frame_wait_updates;
+    }
+
+    /**
+     * @brief Sets the number of times that update must be called
+     * to advance the animation frame of each particle.
+     *
+     * Animation frames are not looped: particles stay in the last frame until they die.
+     *
+     * @param frame_wait_updates Number of updates, or 0 to disable animation.
+     */
+    void set_frame_wait_updates(int frame_wait_updates);
+
+    /**
+     * @brief Indicates if the particles are displayed or not.
+     */
+    [[nodiscard]] bool visible() const
+    {
+        return _visible;
+    }
+
+    /**
+     * @brief Sets if the particles must be displayed or not.
+     */
+    void set_visible(bool visible)
+    {
+        _visible = visible;
+    }
+
+    /**
+     * @brief Emits a new particle.
+     *
+     * If the emitter is full, the particle is not emitted.
+     *
+     * @param position Position of the particle, relative to the center of the screen.
+     * @param velocity Velocity of the particle.
+     * @param lifetime Number of updates until the particle dies (it must be greater than 0).
+     * @return `true` if the particle has been emitted; `false` otherwise.
+     */
+    bool emit(const fixed_point& position, const fixed_point& velocity, int lifetime);
+
+    /**
+     * @brief Kills all particles.
+     */
+    void clear()
+    {
+        _size = 0;
+    }
+
+    /**
+     * @brief Moves all particles, advances their animation and kills the ones without remaining lifetime.
+     */
+    BN_CODE_IWRAM void update();
+
+    /// @cond DO_NOT_DOCUMENT
+
+    [[nodiscard]] BN_CODE_IWRAM int _write_handles(int max_handles, bool fade_enabled, void* hw_handles) const;
+
+    /// @endcond
+
+protected:
+    isprite_particle_emitter(const sprite_item& item, int max_size, fixed* xs, fixed* ys,
+                             fixed* velocity_xs, fixed* velocity_ys, int16_t* lifetimes, uint8_t* frames);
+
+    isprite_particle_emitter(const sprite_shape_size& shape_size, sprite_tiles_ptr&& tiles,
+                             sprite_palette_ptr&& palette, int frames_count, int max_size, fixed* xs, fixed* ys,
+                             fixed* velocity_xs, fixed* velocity_ys, int16_t* lifetimes, uint8_t* frames);
+
+private:
+    sprite_shape_size _shape_size;
+    sprite_tiles_ptr _tiles;
+    sprite_palette_ptr _palette;
+    fixed* _xs;
+    fixed* _ys;
+    fixed* _velocity_xs;
+    fixed* _velocity_ys;
+    int16_t* _lifetimes;
+    uint8_t* _frames;
+    fixed_point _acceleration;
+    int _max_size;
+    int _size = 0;
+    int _frames_count;
+    int _max_handles = BN_CFG_SPRITES_MAX_PARTICLE_HANDLES;
+    int _frame_wait_updates = 0;
+    int _frame_counter = 0;
+    int8_t _bg_priority = 3;
+    bool _visible = true;
+};
+
+
+/**
+ * @brief Lightweight particle emitter with a fixed maximum number of particles.
+ *
+ * @tparam MaxSize Maximum number of alive particles.
+ *
+ * @ingroup sprite
+ */
+template<int MaxSize>
+class sprite_particle_emitter : public isprite_particle_emitter
+{
+    static_assert(MaxSize > 0 && MaxSize <= 32767);
+
+public:
+    /**
+     * @brief Constructor.
+     *
+     * All tile sets of the given sprite_item are uploaded to VRAM as a single block,
+     * so the total number of tiles must be valid for a sprite_tiles_item with one tile set.
+     *
+     * @param item sprite_item with the shape, size, tiles and colors of the particles.
+     * Each tile set of the sprite_item is an animation frame.
+     */
+    explicit sprite_particle_emitter(const sprite_item& item) :
+        isprite_particle_emitter(item, MaxSize, _xs_buffer, _ys_buffer, _velocity_xs_buffer, _velocity_ys_buffer,
+                                 _lifetimes_buffer, _frames_buffer)
+    {
+    }
+
+    /**
+     * @brief Constructor.
+     * @param shape_size Shape and size of the particles.
+     * @param tiles Sprite tiles shared by all particles.
+     * @param palette Sprite palette shared by all particles.
+     * @param frames_count Number of animation frames contained in tiles.
+     */
+    sprite_particle_emitter(const sprite_shape_size& shape_size, sprite_tiles_ptr tiles,
+                            sprite_palette_ptr palette, int frames_count = 1) :
+        isprite_particle_emitter(shape_size, move(tiles), move(palette), frames_count, MaxSize, _xs_buffer,
+                                 _ys_buffer, _velocity_xs_buffer, _velocity_ys_buffer, _lifetimes_buffer,
+                                 _frames_buffer)
+    {
+    }
+
+private:
+    fixed _xs_buffer[MaxSize];
+    fixed _ys_buffer[MaxSize];
+    fixed _velocity_xs_buffer[MaxSize];
+    fixed _velocity_ys_buffer[MaxSize];
+    int16_t _lifetimes_buffer[MaxSize];
+    uint8_t _frames_buffer[MaxSize];
+};
+
+}
+
+#endif
@@ -35,6 +35,14 @@ namespace bn::sprite_tiles
      */
     [[nodiscard]] int available_tiles_count();
 
+    /**
+     * @brief Returns the number of tiles of the biggest block of contiguous available sprite tiles.
+     *
+     * Creating a sprite_tiles_ptr with more tiles than this value fails,
+     * even if there's enough available tiles.
+     */
+    [[nodiscard]] int available_contiguous_tiles_count();
+
     /**
      * @brief Returns the number of used sprite tile sets created with sprite_tiles_ptr static constructors.
      */
@@ -46,6 +54,32 @@ namespace bn::sprite_tiles
      */
     [[nodiscard]] int available_items_count();
 
+    /**
+     * @brief Returns the number of bytes of sprite tiles which don't fit in the next V-Blank upload budget.
+     *
+     * It is always 0 if BN_CFG_SPRITE_TILES_MAX_COMMIT_BYTES is 0.
+     */
+    [[nodiscard]] int queued_bytes();
+
+    /**
+     * @brief Starts moving used sprite tiles to close the gaps between them.
+     *
+     * Sprite tiles are relocated incrementally in the next V-Blanks,
+     * up to @a BN_CFG_SPRITE_TILES_COMPACTION_MAX_TILES tiles in each one.
+     *
+     * Only sprite tiles with a source tiles reference (sprite_tiles_ptr::tiles_ref) are relocated:
+     * allocated sprite tiles are kept in place, since their VRAM can be referenced by the user.
+     *
+     * The handles of the sprites, sprite particles and sprite third attributes H-Blank effects
+     * which use relocated tiles are updated in the same V-Blank.
+     */
+    void compact();
+
+    /**
+     * @brief Indicates if sprite tiles are being compacted or not.
+     */
+    [[nodiscard]] bool compacting();
+
     #if BN_CFG_LOG_ENABLED || BN_DOXYGEN
         /**
          * @brief Logs the current status of the sprite tiles manager.
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2020 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SPRITE_TILES_DELTA_ITEM_H
+#define BN_SPRITE_TILES_DELTA_ITEM_H
+
+/**
+ * @file
+ * bn::sprite_tiles_delta_item header file.
+ *
+ * @ingroup sprite
+ * @ingroup tile
+ * @ingroup tool
+ */
+
+#include "bn_span.h"
+#include "bn_tile.h"
+#include "bn_bpp_mode.h"
+#include "bn_sprite_tiles_item.h"
+
+namespace bn
+{
+
+/**
+ * @brief Contains the tiles which change between the animation frames of a sprite,
+ * so they can be streamed to VRAM with a sprite_delta_animate_action.
+ *
+ * The assets conversion tools generate an object of this type in the build folder for each *.bmp file
+ * with `sprite` type and `delta_animation` enabled.
+ *
+ * The tiles of each frame are stored as a delta of the frame displayed two frames before,
+ * since sprite_delta_animate_action uploads them to a double-buffered VRAM slot:
+ *
+ * * Deltas 0 and 1 contain all tiles of the frames 0 and 1.
+ * * Delta i (2 <= i < graphics_count) contains the tiles of the frame i which differ from the frame i - 2.
+ * * Deltas graphics_count and graphics_count + 1 contain the tiles of the frames 0 and 1
+ * which differ from the frames graphics_count - 2 and graphics_count - 1, so the animation can be looped.
+ *
+ * The tiles are not copied but referenced, so they should outlive the sprite_tiles_delta_item
+ * to avoid dangling references.
+ *
+ * @ingroup sprite
+ * @ingroup tile
+ * @ingroup tool
+ */
+class sprite_tiles_delta_item
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param tiles_ref Reference to the tiles of all deltas.
+     *
+     * The tiles are not copied but referenced, so they should outlive the sprite_tiles_delta_item
+     * to avoid dangling references.
+     *
+     * @param tile_indexes_ref Reference to the index in its frame of each tile of tiles_ref.
+     * @param offsets_ref Reference to the index in tiles_ref of the first tile of each delta,
+     * followed by the size of tiles_ref.
+     * @param bpp tiles_ref bits per pixel.
+     * @param tiles_count_per_graphic Number of sprite tiles contained in each frame.
+     */
+    constexpr sprite_tiles_delta_item(const span<const tile>& tiles_ref, const span<const uint8_t>& tile_indexes_ref,
+                                      const span<const uint16_t>& offsets_ref, bpp_mode bpp,
+                                      int tiles_count_per_graphic) :
+        _tiles_ref(tiles_ref),
+        _tile_indexes_ref(tile_indexes_ref),
+        _offsets_ref(offsets_ref),
+        _bpp(bpp),
+        _tiles_count_per_graphic(tiles_count_per_graphic)
+    {
+        BN_ASSERT(tile_indexes_ref.size() == tiles_ref.size(),
+                  "Invalid tile indexes count: ", tile_indexes_ref.size(), " - ", tiles_ref.size());
+        BN_ASSERT(offsets_ref.size() >= 5, "Invalid offsets count: ", offsets_ref.size());
+        BN_ASSERT(sprite_tiles_item::valid_tiles_count(tiles_count_per_graphic, bpp),
+                  "Invalid tiles count per graphic: ", tiles_count_per_graphic, " - ", int(bpp));
+    }
+
+    /**
+     * @brief Returns the reference to the tiles of all deltas.
+     *
+     * The tiles are not copied but referenced, so they should outlive the sprite_tiles_delta_item
+     * to avoid dangling references.
+     */
+    [[nodiscard]] constexpr const span<const tile>& tiles_ref() const
+    {
+        return _tiles_ref;
+    }
+
+    /**
+     * @brief Returns the reference to the index in its frame of each tile of tiles_ref.
+     */
+    [[nodiscard]] constexpr const span<const uint8_t>& tile_indexes_ref() const
+    {
+        return _tile_indexes_ref;
+    }
+
+    /**
+     * @brief Returns the reference to the index in tiles_ref of the first tile of each delta,
+     * followed by the size of tiles_ref.
+     */
+    [[nodiscard]] constexpr const span<const uint16_t>& offsets_ref() const
+    {
+        return _offsets_ref;
+    }
+
+    /**
+     * @brief Returns the bits per pixel of the referenced tiles.
+     */
+    [[nodiscard]] constexpr bpp_mode bpp() const
+    {
+        return _bpp;
+    }
+
+    /**
+     * @brief Returns the number of animation frames.
+     */
+    [[nodiscard]] constexpr int graphics_count() const
+    {
+        return _offsets_ref.size() - 3;
+    }
+
+    /**
+     * @brief Returns the number of sprite tiles contained in each frame.
+     */
+    [[nodiscard]] constexpr int tiles_count_per_graphic() const
+    {
+        return _tiles_count_per_graphic;
+    }
+
+    /**
+     * @brief Returns the number of deltas (graphics_count() + 2).
+     */
+    [[nodiscard]] constexpr int deltas_count() const
+    {
+        return _offsets_ref.size() - 1;
+    }
+
+    /**
+     * @brief Returns the reference to the tiles of the delta indicated by delta_index.
+     */
+    [[nodiscard]] constexpr span<const tile> delta_tiles_ref(int delta_index) const
+    {
+        BN_ASSERT(delta_index >= 0 && delta_index < deltas_count(), "Invalid delta index: ", delta_index);
+
+        int offset = _offsets_ref[delta_index];
+        return span<const tile>(_tiles_ref.data() + offset, _offsets_ref[delta_index + 1] - offset);
+    }
+
+    /**
+     * @brief Returns the reference to the index in its frame of each tile of the delta indicated by delta_index.
+     */
+    [[nodiscard]] constexpr span<const uint8_t> delta_tile_indexes_ref(int delta_index) const
+    {
+        BN_ASSERT(delta_index >= 0 && delta_index < deltas_count(), "Invalid delta index: ", delta_index);
+
+        int offset = _offsets_ref[delta_index];
+        return span<const uint8_t>(_tile_indexes_ref.data() + offset, _offsets_ref[delta_index + 1] - offset);
+    }
+
+    /**
+     * @brief Equal operator.
+     * @param a First sprite_tiles_delta_item to compare.
+     * @param b Second sprite_tiles_delta_item to compare.
+     * @return `true` if the first sprite_tiles_delta_item is equal to the second one, otherwise `false`.
+     */
+    [[nodiscard]] constexpr friend bool operator==(const sprite_tiles_delta_item& a,
+                                                   const sprite_tiles_delta_item& b)
+    {
+        return a._tiles_ref.data() == b._tiles_ref.data() && a._tiles_ref.size() == b._tiles_ref.size() &&
+                a._offsets_ref.data() == b._offsets_ref.data();
+    }
+
+    /**
+     * @brief Not equal operator.
+     * @param a First sprite_tiles_delta_item to compare.
+     * @param b Second sprite_tiles_delta_item to compare.
+     * @return `true` if the first sprite_tiles_delta_item is not equal to the second one, otherwise `false`.
+     */
+    [[nodiscard]] constexpr friend bool operator!=(const sprite_tiles_delta_item& a,
+                                                   const sprite_tiles_delta_item& b)
+    {
+        return ! (a == b);
+    }
+
+private:
+    span<const tile> _tiles_ref;
+    span<const uint8_t> _tile_indexes_ref;
+    span<const uint16_t> _offsets_ref;
+    bpp_mode _bpp;
+    int _tiles_count_per_graphic;
+};
+
+}
+
+#endif
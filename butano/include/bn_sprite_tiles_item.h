@@ -19,6 +19,7 @@
 #include "bn_tile.h"
 #include "bn_bpp_mode.h"
 #include "bn_optional_fwd.h"
+#include "bn_compression_type.h"
 
 namespace bn
 {
@@ -102,6 +103,40 @@ public:
                   "Invalid tiles count per graphic: ", _tiles_count_per_graphic, " - ", int(bpp));
     }
 
+    /**
+     * @brief Constructor.
+     * @param tiles_ref Reference to one or more compressed sprite tile sets.
+     *
+     * Each tile set is a compressed data block, and all blocks must be padded to the same size.
+     *
+     * The tiles are not copied but referenced, so they should outlive the sprite_tiles_item
+     * to avoid dangling references.
+     *
+     * @param bpp tiles_ref bits per pixel.
+     * @param compression Compression type of tiles_ref.
+     * @param graphics_count Number of sprite tile sets contained in tiles_ref.
+     * @param tiles_count_per_graphic Number of sprite tiles contained in each tile set once decompressed.
+     */
+    constexpr sprite_tiles_item(const span<const tile>& tiles_ref, bpp_mode bpp, compression_type compression,
+                                int graphics_count, int tiles_count_per_graphic) :
+        _tiles_ref(tiles_ref),
+        _bpp(bpp),
+        _compression(compression),
+        _graphics_count(graphics_count),
+        _tiles_count_per_graphic(tiles_count_per_graphic)
+    {
+        BN_ASSERT(graphics_count > 0, "Invalid graphics count: ", graphics_count);
+        BN_ASSERT(graphics_count <= tiles_ref.size(),
+                  "Invalid tiles or graphics count: ", tiles_ref.size(), " - ", graphics_count);
+        BN_ASSERT(tiles_ref.size() % graphics_count == 0,
+                  "Invalid tiles or graphics count: ", tiles_ref.size(), " - ", graphics_count);
+        BN_ASSERT(compression != compression_type::NONE ||
+                  tiles_ref.size() == tiles_count_per_graphic * graphics_count,
+                  "Invalid tiles or graphics count: ", tiles_ref.size(), " - ", graphics_count);
+        BN_ASSERT(valid_tiles_count(tiles_count_per_graphic, bpp),
+                  "Invalid tiles count per graphic: ", tiles_count_per_graphic, " - ", int(bpp));
+    }
+
     /**
      * @brief Returns the reference to one or more sprite tile sets.
      *
@@ -121,6 +156,14 @@ public:
         return _bpp;
     }
 
+    /**
+     * @brief Returns the compression type of the referenced tiles.
+     */
+    [[nodiscard]] constexpr compression_type compression() const
+    {
+        return _compression;
+    }
+
     /**
      * @brief Returns the number of sprite tile sets contained in tiles_ref.
      */
@@ -130,7 +173,7 @@ public:
     }
 
     /**
-     * @brief Returns the number of sprite tiles contained in each sprite tile set.
+     * @brief Returns the number of sprite tiles contained in each sprite tile set once decompressed.
      */
     [[nodiscard]] constexpr int tiles_count_per_graphic() const
     {
@@ -139,14 +182,18 @@ public:
 
     /**
      * @brief Returns the reference to the first sprite tile set.
+     *
+     * If the tiles are compressed, it references the compressed data block.
      */
     [[nodiscard]] constexpr span<const tile> graphics_tiles_ref() const
     {
-        return span<const tile>(_tiles_ref.data(), _tiles_count_per_graphic);
+        return span<const tile>(_tiles_ref.data(), _graphics_tiles_ref_size());
     }
 
     /**
      * @brief Returns the reference to the sprite tile set indicated by graphics_index.
+     *
+     * If the tiles are compressed, it references the compressed data block.
      */
     [[nodiscard]] constexpr span<const tile> graphics_tiles_ref(int graphics_index) const
     {
@@ -154,7 +201,7 @@ public:
         BN_ASSERT(graphics_index < _graphics_count,
                   "Invalid graphics index: ", graphics_index, " - ", _graphics_count);
 
-        int tiles_count = _tiles_count_per_graphic;
+        int tiles_count = _graphics_tiles_ref_size();
         return span<const tile>(_tiles_ref.data() + (graphics_index * tiles_count), tiles_count);
     }
 
@@ -290,7 +337,7 @@ public:
     [[nodiscard]] constexpr friend bool operator==(const sprite_tiles_item& a, const sprite_tiles_item& b)
     {
         return a._tiles_ref.data() == b._tiles_ref.data() && a._tiles_ref.size() == b._tiles_ref.size() &&
-                a._graphics_count == b._graphics_count;
+                a._compression == b._compression && a._graphics_count == b._graphics_count;
     }
 
     /**
@@ -307,8 +354,19 @@ public:
 private:
     span<const tile> _tiles_ref;
     bpp_mode _bpp;
+    compression_type _compression = compression_type::NONE;
     int _graphics_count;
     int _tiles_count_per_graphic;
+
+    [[nodiscard]] constexpr int _graphics_tiles_ref_size() const
+    {
+        if(_compression == compression_type::NONE)
+        {
+            return _tiles_count_per_graphic;
+        }
+
+        return _tiles_ref.size() / _graphics_count;
+    }
 };
 
 }
@@ -25,6 +25,7 @@ namespace bn
 class tile;
 class sprite_tiles_item;
 enum class bpp_mode;
+enum class compression_type;
 
 /**
  * @brief std::shared_ptr like smart pointer that retains shared ownership of the tiles of a sprite.
@@ -251,9 +252,16 @@ public:
      */
     [[nodiscard]] int tiles_count() const;
 
+    /**
+     * @brief Returns the compression type of the referenced tiles.
+     */
+    [[nodiscard]] compression_type compression() const;
+
     /**
      * @brief Returns the referenced tiles unless it was created with allocate or allocate_optional.
      * In that case, it returns bn::nullopt.
+     *
+     * If the referenced tiles are compressed, it returns the compressed data block.
      */
     [[nodiscard]] optional<span<const tile>> tiles_ref() const;
 
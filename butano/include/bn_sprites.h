@@ -13,8 +13,18 @@
  * @ingroup sprite
  */
 
+#include "bn_span_fwd.h"
+#include "bn_config_log.h"
+#include "bn_config_doxygen.h"
+#include "bn_config_sprites.h"
 #include "../hw/include/bn_hw_sprites_constants.h"
 
+namespace bn
+{
+    class sprite_ptr;
+    class fixed_point;
+}
+
 /**
  * @brief Sprites related functions.
  *
@@ -69,6 +79,128 @@ namespace bn::sprites
     {
         return 32767;
     }
+
+    /**
+     * @brief Sets the position of multiple sprites in one pass
+     * (relative to their cameras, if they have them).
+     *
+     * Sprites whose position doesn't change are skipped.
+     *
+     * @param sprites Sprites to update.
+     * @param positions New position of each sprite. It must have the same size as sprites.
+     */
+    void set_positions(const span<const sprite_ptr>& sprites, const span<const fixed_point>& positions);
+
+    /**
+     * @brief Sets the priority relative to other sprites of multiple sprites in one pass.
+     *
+     * Sprites whose z order doesn't change are skipped.
+     *
+     * @param sprites Sprites to update.
+     * @param z_orders New z order of each sprite in the range [-32767..32767].
+     * It must have the same size as sprites.
+     */
+    void set_z_orders(const span<const sprite_ptr>& sprites, const span<const int>& z_orders);
+
+    /**
+     * @brief Sets if multiple sprites are flipped in the horizontal axis or not in one pass.
+     *
+     * Sprites whose horizontal flip doesn't change are skipped.
+     *
+     * @param sprites Sprites to update.
+     * @param horizontal_flips New horizontal flip of each sprite. It must have the same size as sprites.
+     */
+    void set_horizontal_flips(const span<const sprite_ptr>& sprites, const span<const bool>& horizontal_flips);
+
+    /**
+     * @brief Sets if multiple sprites are flipped in the vertical axis or not in one pass.
+     *
+     * Sprites whose vertical flip doesn't change are skipped.
+     *
+     * @param sprites Sprites to update.
+     * @param vertical_flips New vertical flip of each sprite. It must have the same size as sprites.
+     */
+    void set_vertical_flips(const span<const sprite_ptr>& sprites, const span<const bool>& vertical_flips);
+
+    #if BN_CFG_SPRITES_SCANLINE_CYCLES_ENABLED || BN_DOXYGEN
+        /**
+         * @brief Returns the maximum number of OBJ rendering cycles available in each scanline.
+         *
+         * Sprites which don't fit in this budget are not displayed in that scanline.
+         */
+        [[nodiscard]] constexpr int max_scanline_cycles()
+        {
+            return hw::sprites::max_scanline_cycles();
+        }
+
+        /**
+         * @brief Returns the estimated number of OBJ rendering cycles spent in the given scanline in the last frame.
+         * @param scanline Scanline index in the range [0..display::height()).
+         */
+        [[nodiscard]] int scanline_cycles(int scanline);
+
+        /**
+         * @brief Returns the highest estimated number of OBJ rendering cycles spent in a scanline in the last frame.
+         */
+        [[nodiscard]] int peak_scanline_cycles();
+
+        /**
+         * @brief Indicates if sprites flicker mode is enabled or not.
+         */
+        [[nodiscard]] bool flicker_enabled();
+
+        /**
+         * @brief Sets if sprites flicker mode must be enabled or not.
+         *
+         * When it is enabled and a scanline needs more than max_scanline_cycles() cycles,
+         * the OAM order of the visible sprites is reversed every frame,
+         * so the sprites which can't be displayed are not always the same ones.
+         *
+         * Reversing OAM order also reverses how sprites with the same background priority overlap each other.
+         *
+         * Flicker mode is ignored if sprite multiplexing is enabled.
+         */
+        void set_flicker_enabled(bool flicker_enabled);
+
+        #if BN_CFG_LOG_ENABLED || BN_DOXYGEN
+            /**
+             * @brief Logs a histogram with the estimated number of OBJ rendering cycles spent
+             * in each group of 8 scanlines in the last frame.
+             */
+            void log_scanline_cycles();
+        #endif
+    #endif
+
+    #if BN_CFG_SPRITES_MULTIPLEXING_ENABLED || BN_DOXYGEN
+        /**
+         * @brief Returns the number of horizontal screen bands used by sprite multiplexing.
+         */
+        [[nodiscard]] constexpr int multiplexing_bands_count()
+        {
+            return BN_CFG_SPRITES_MULTIPLEXING_BANDS;
+        }
+
+        /**
+         * @brief Returns the number of OAM entries used by the given sprite multiplexing band in the last frame.
+         * @param band Sprite multiplexing band index in the range [0..multiplexing_bands_count()).
+         */
+        [[nodiscard]] int multiplexing_band_items_count(int band);
+
+        /**
+         * @brief Returns the number of visible sprites which couldn't be placed in any OAM entry in the last frame.
+         *
+         * Sprites which couldn't be placed are not displayed until there's a free OAM entry for them.
+         */
+        [[nodiscard]] int multiplexing_dropped_items_count();
+
+        #if BN_CFG_LOG_ENABLED || BN_DOXYGEN
+            /**
+             * @brief Logs the occupancy of each sprite multiplexing band
+             * and the sprites which couldn't be placed in the last frame.
+             */
+            void log_multiplexing_status();
+        #endif
+    #endif
 }
 
 #endif
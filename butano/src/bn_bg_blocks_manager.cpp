@@ -5,6 +5,7 @@
 
 #include "bn_bg_blocks_manager.h"
 
+#include "bn_limits.h"
 #include "bn_vector.h"
 #include "bn_bgs_manager.h"
 #include "bn_unordered_map.h"
@@ -37,6 +38,9 @@ namespace
 {
     static_assert(BN_CFG_BG_BLOCKS_MAX_ITEMS > 0 && BN_CFG_BG_BLOCKS_MAX_ITEMS <= hw::bg_tiles::blocks_count());
     static_assert(power_of_two(BN_CFG_BG_BLOCKS_MAX_ITEMS));
+    static_assert(BN_CFG_BG_BLOCKS_MAX_COMMIT_BYTES >= 0);
+    static_assert(BN_CFG_BG_BLOCKS_MAX_TILES_CACHES >= 0);
+    static_assert(BN_CFG_BG_BLOCKS_TILES_CACHE_MAX_TILES > 0 && BN_CFG_BG_BLOCKS_TILES_CACHE_MAX_TILES <= 1024);
 
     [[nodiscard]] constexpr int _tiles_to_half_words(int tiles)
     {
@@ -95,20 +99,181 @@ namespace
     };
 
 
+    #if BN_CFG_BG_BLOCKS_MAX_TILES_CACHES
+        class tiles_cache_type
+        {
+
+        public:
+            static constexpr int max_source_tiles = 1024;
+            static constexpr int max_slots = BN_CFG_BG_BLOCKS_TILES_CACHE_MAX_TILES;
+            static constexpr uint16_t no_slot = numeric_limits<uint16_t>::max();
+
+            const tile* source_tiles = nullptr;
+
+            void init(const tile* source_tiles_ptr, int source_tiles_count, int slots_count, int tiles_per_slot)
+            {
+                BN_ASSERT(source_tiles_count <= max_source_tiles * tiles_per_slot,
+                          "Too many source tiles: ", source_tiles_count, " - ", max_source_tiles * tiles_per_slot);
+                BN_ASSERT(slots_count <= max_slots, "Too many cached tiles: ", slots_count, " - ", max_slots);
+
+                source_tiles = source_tiles_ptr;
+                _source_tiles_count = source_tiles_count / tiles_per_slot;
+                _tiles_per_slot = tiles_per_slot;
+                memory::set_half_words(no_slot, max_source_tiles, _tile_slots);
+                memory::set_half_words(no_slot, 32 * 32, _map_slots);
+
+                for(int slot = 0; slot < slots_count; ++slot)
+                {
+                    _slot_tiles[slot] = no_slot;
+                    _slot_usages[slot] = 0;
+                    _slot_prev[slot] = uint16_t(slot - 1);
+                    _slot_next[slot] = uint16_t(slot + 1);
+                }
+
+                _slot_prev[0] = no_slot;
+                _slot_next[slots_count - 1] = no_slot;
+                _lru_first = 0;
+                _lru_last = uint16_t(slots_count - 1);
+            }
+
+            [[nodiscard]] unsigned cell(unsigned source_cell, int map_index, tile* vram_tiles)
+            {
+                // Cells referencing the same slot keep it cached, and the least recently used slot is reused:
+                int tile_index = int(source_cell & 1023);
+                BN_ASSERT(tile_index < _source_tiles_count, "Invalid tile index: ", tile_index);
+
+                int slot = _tile_slots[tile_index];
+
+                if(slot == no_slot)
+                {
+                    slot = _lru_first;
+                    BN_ASSERT(slot != no_slot, "Tiles cache is full");
+
+                    if(int old_tile_index = _slot_tiles[slot]; old_tile_index != no_slot)
+                    {
+                        _tile_slots[old_tile_index] = no_slot;
+                    }
+
+                    _tile_slots[tile_index] = uint16_t(slot);
+                    _slot_tiles[slot] = uint16_t(tile_index);
+
+                    int tiles_per_slot = _tiles_per_slot;
+                    memory::copy(source_tiles[tile_index * tiles_per_slot], tiles_per_slot,
+                                 vram_tiles[slot * tiles_per_slot]);
+                }
+
+                _set_map_slot(map_index, slot);
+                return (source_cell & ~1023u) | unsigned(slot);
+            }
+
+            void clear_cell(int map_index)
+            {
+                _set_map_slot(map_index, no_slot);
+            }
+
+        private:
+            uint16_t _tile_slots[max_source_tiles];
+            uint16_t _map_slots[32 * 32];
+            uint16_t _slot_tiles[max_slots];
+            uint16_t _slot_usages[max_slots];
+            uint16_t _slot_prev[max_slots];
+            uint16_t _slot_next[max_slots];
+            uint16_t _lru_first = no_slot;
+            uint16_t _lru_last = no_slot;
+            int _source_tiles_count = 0;
+            int _tiles_per_slot = 1;
+
+            void _set_map_slot(int map_index, int slot)
+            {
+                int old_slot = _map_slots[map_index];
+
+                if(old_slot != slot)
+                {
+                    _map_slots[map_index] = uint16_t(slot);
+
+                    if(slot != no_slot && ! _slot_usages[slot]++)
+                    {
+                        _remove_unused_slot(slot);
+                    }
+
+                    if(old_slot != no_slot && ! --_slot_usages[old_slot])
+                    {
+                        _add_unused_slot(old_slot);
+                    }
+                }
+            }
+
+            void _remove_unused_slot(int slot)
+            {
+                int prev = _slot_prev[slot];
+                int next = _slot_next[slot];
+
+                if(prev == no_slot)
+                {
+                    _lru_first = uint16_t(next);
+                }
+                else
+                {
+                    _slot_next[prev] = uint16_t(next);
+                }
+
+                if(next == no_slot)
+                {
+                    _lru_last = uint16_t(prev);
+                }
+                else
+                {
+                    _slot_prev[next] = uint16_t(prev);
+                }
+            }
+
+            void _add_unused_slot(int slot)
+            {
+                int last = _lru_last;
+                _slot_prev[slot] = uint16_t(last);
+                _slot_next[slot] = no_slot;
+
+                if(last == no_slot)
+                {
+                    _lru_first = uint16_t(slot);
+                }
+                else
+                {
+                    _slot_next[last] = uint16_t(slot);
+                }
+
+                _lru_last = uint16_t(slot);
+            }
+        };
+    #endif
+
+
     class item_type
     {
 
     public:
         const uint16_t* data = nullptr;
+        const uint16_t* column_major_data = nullptr;
+        const uint16_t* metatiles_data = nullptr;
         unsigned usages = 0;
         optional<regular_bg_tiles_ptr> regular_tiles;
         optional<affine_bg_tiles_ptr> affine_tiles;
         optional<bg_palette_ptr> palette;
+
+        #if BN_CFG_BG_BLOCKS_MAX_TILES_CACHES
+            tiles_cache_type* tiles_cache = nullptr;
+        #endif
+
         uint16_t width = 0; // If is_tiles == true, it stores half_words.
         uint16_t height = 0;
         uint8_t start_block = 0;
         uint8_t blocks_count = 0;
         uint8_t next_index = max_list_items;
+        uint8_t metatile_shift = 0;
+        uint8_t commit_min_x = 0; // If commit_region == true, the commit is limited to these cells.
+        uint8_t commit_min_y = 0;
+        uint8_t commit_max_x = 0;
+        uint8_t commit_max_y = 0;
 
     private:
         unsigned _status: 2 = unsigned(status_type::FREE);
@@ -117,6 +282,10 @@ namespace
         bool is_tiles: 1 = false;
         bool is_affine: 1 = false;
         bool commit: 1 = false;
+        bool resident: 1 = false;
+        bool queued: 1 = false;
+        bool commit_region: 1 = false;
+        bool relocated: 1 = false;
 
         [[nodiscard]] status_type status() const
         {
@@ -133,6 +302,28 @@ namespace
             return _half_words_to_tiles(width);
         }
 
+        void set_regular_map_item_data(const regular_bg_map_item& map_item)
+        {
+            column_major_data = map_item.column_major_cells_ptr();
+            metatiles_data = map_item.metatiles_cells_ptr();
+            metatile_shift = uint8_t(map_item.metatile_size() >> 1);
+        }
+
+        void reset_regular_map_item_data()
+        {
+            column_major_data = nullptr;
+            metatiles_data = nullptr;
+            metatile_shift = 0;
+
+            #if BN_CFG_BG_BLOCKS_MAX_TILES_CACHES
+                if(tiles_cache)
+                {
+                    tiles_cache->source_tiles = nullptr;
+                    tiles_cache = nullptr;
+                }
+            #endif
+        }
+
         [[nodiscard]] int regular_tiles_offset() const
         {
             int tiles_start_block = regular_tiles->id();
@@ -377,11 +568,38 @@ namespace
         int to_remove_blocks_count = 0;
         bool check_commit = false;
         bool delay_commit = false;
+        bool check_compaction = false;
+        bool compacting = false;
+
+        #if BN_CFG_BG_BLOCKS_MAX_COMMIT_BYTES
+            int queued_tiles_bytes = 0;
+            int queued_map_bytes = 0;
+        #endif
+
+        #if BN_CFG_BG_BLOCKS_MAX_TILES_CACHES
+            tiles_cache_type tiles_caches[BN_CFG_BG_BLOCKS_MAX_TILES_CACHES];
+        #endif
     };
 
     BN_DATA_EWRAM static_data data;
 
 
+    [[nodiscard]] int _available_contiguous_blocks_count()
+    {
+        int result = 0;
+
+        for(const item_type& item : data.items)
+        {
+            if(item.status() == status_type::FREE)
+            {
+                result = max(result, int(item.blocks_count));
+            }
+        }
+
+        return result;
+    }
+
+
     #if BN_CFG_BG_BLOCKS_LOG_ENABLED
         void _log_status()
         {
@@ -445,9 +663,11 @@ namespace
             BN_LOG(']');
 
             BN_LOG("free_blocks_count: ", data.free_blocks_count);
+            BN_LOG("available_contiguous_blocks_count: ", _available_contiguous_blocks_count());
             BN_LOG("to_remove_blocks_count: ", data.to_remove_blocks_count);
             BN_LOG("check_commit: ", (data.check_commit ? "true" : "false"));
             BN_LOG("delay_commit: ", (data.delay_commit ? "true" : "false"));
+            BN_LOG("compacting: ", (data.compacting ? "true" : "false"));
         }
 
         #define BN_BG_BLOCKS_LOG BN_LOG
@@ -629,6 +849,132 @@ namespace
         return -1;
     }
 
+    void _expand_regular_metatiles_row(const item_type& item, int x, int y, uint16_t* cells)
+    {
+        // Metatile indexes are stored row by row, and the cells of each metatile too:
+        int shift = item.metatile_shift;
+        int mask = (1 << shift) - 1;
+        int metatile_cells_shift = shift * 2;
+        const uint16_t* metatile_indexes = item.data + ((y >> shift) * (item.width >> shift));
+        const uint16_t* metatiles_row_cells = item.metatiles_data + ((y & mask) << shift);
+
+        for(int ix = x, limit = x + 32; ix < limit; ++ix)
+        {
+            *cells = metatiles_row_cells[(metatile_indexes[ix >> shift] << metatile_cells_shift) + (ix & mask)];
+            ++cells;
+        }
+    }
+
+    void _expand_regular_metatiles_col(const item_type& item, int x, int y, uint16_t* cells)
+    {
+        int shift = item.metatile_shift;
+        int mask = (1 << shift) - 1;
+        int metatile_cells_shift = shift * 2;
+        int metatiles_width = item.width >> shift;
+        const uint16_t* metatile_indexes = item.data + (x >> shift);
+        const uint16_t* metatiles_col_cells = item.metatiles_data + (x & mask);
+        int limit = min(y + 32, int(item.height));
+
+        for(int iy = y; iy < limit; ++iy)
+        {
+            int metatile_index = metatile_indexes[(iy >> shift) * metatiles_width];
+            *cells = metatiles_col_cells[(metatile_index << metatile_cells_shift) + ((iy & mask) << shift)];
+            ++cells;
+        }
+
+        // Cells below the map are outside of the visible area, so they are overwritten before being displayed:
+        if(int remaining_cells = 32 - (limit - y))
+        {
+            memory::clear(remaining_cells, *cells);
+        }
+    }
+
+    #if BN_CFG_BG_BLOCKS_MAX_TILES_CACHES
+        [[nodiscard]] tile* _tiles_cache_vram(const item_type& item)
+        {
+            return reinterpret_cast<tile*>(hw::bg_blocks::vram(item.regular_tiles->id()));
+        }
+
+        void _cache_regular_map_row(const item_type& item, int x, int y, const uint16_t* source_data,
+                                    uint16_t* cells)
+        {
+            tiles_cache_type& tiles_cache = *item.tiles_cache;
+            tile* vram_tiles = _tiles_cache_vram(item);
+            int map_row_index = (y & 31) * 32;
+
+            for(int index = 0; index < 32; ++index)
+            {
+                int map_index = map_row_index + ((x + index) & 31);
+                cells[index] = uint16_t(tiles_cache.cell(source_data[index], map_index, vram_tiles));
+            }
+        }
+
+        void _cache_regular_map_col(const item_type& item, int x, int y, const uint16_t* source_data,
+                                    int source_stride, uint16_t* cells)
+        {
+            tiles_cache_type& tiles_cache = *item.tiles_cache;
+            tile* vram_tiles = _tiles_cache_vram(item);
+            int map_col_index = x & 31;
+            int cells_count = min(32, item.height - y);
+
+            for(int index = 0; index < cells_count; ++index)
+            {
+                int map_index = (((y + index) & 31) * 32) + map_col_index;
+                cells[index] = uint16_t(tiles_cache.cell(*source_data, map_index, vram_tiles));
+                source_data += source_stride;
+            }
+
+            // Cells below the map are outside of the visible area, so they don't reference cached tiles:
+            for(int index = cells_count; index < 32; ++index)
+            {
+                tiles_cache.clear_cell((((y + index) & 31) * 32) + map_col_index);
+                cells[index] = 0;
+            }
+        }
+    #endif
+
+    void _copy_regular_map_cells(const uint16_t* source_data_ptr, int half_words, unsigned tiles_offset,
+                                 unsigned palette_offset, uint16_t* destination_vram_ptr)
+    {
+        if(tiles_offset || palette_offset)
+        {
+            hw::bg_blocks::copy_regular_bg_map_cells_offset(source_data_ptr, half_words, tiles_offset,
+                                                            palette_offset, destination_vram_ptr);
+        }
+        else
+        {
+            memory::copy(*source_data_ptr, half_words, *destination_vram_ptr);
+        }
+    }
+
+    [[nodiscard]] int _regular_map_cell_index(int map_width, int x, int y)
+    {
+        // Maps with more than 32 columns or rows are stored in consecutive 32x32 screen blocks:
+        int screen_block = (x / 32) + ((y / 32) * (map_width / 32));
+        return (screen_block * 32 * 32) + ((y & 31) * 32) + (x & 31);
+    }
+
+    void _commit_regular_map_region(const item_type& item, unsigned tiles_offset, unsigned palette_offset,
+                                    uint16_t* destination_vram_ptr)
+    {
+        const uint16_t* source_data_ptr = item.data;
+        int map_width = item.width;
+        int max_x = item.commit_max_x;
+
+        for(int y = item.commit_min_y, max_y = item.commit_max_y; y <= max_y; ++y)
+        {
+            // Each row is copied in runs which don't cross screen block boundaries:
+            for(int x = item.commit_min_x; x <= max_x; )
+            {
+                int run_max_x = min(max_x, x | 31);
+                int cell_index = _regular_map_cell_index(map_width, x, y);
+                _copy_regular_map_cells(source_data_ptr + cell_index, run_max_x - x + 1, tiles_offset,
+                                        palette_offset, destination_vram_ptr + cell_index);
+                x = run_max_x + 1;
+            }
+        }
+    }
+
     void _commit_item(const item_type& item)
     {
         const uint16_t* source_data_ptr = item.data;
@@ -684,46 +1030,26 @@ namespace
             uint16_t* destination_vram_ptr = hw::bg_blocks::vram(item.start_block);
             auto tiles_offset = unsigned(item.regular_tiles_offset());
             auto palette_offset = unsigned(item.palette_offset());
-            int half_words = item.width * item.height;
 
-            if(tiles_offset)
+            if(item.commit_region)
             {
-                if(palette_offset)
-                {
-                    for(int index = 0; index < half_words; ++index)
-                    {
-                        hw::bg_blocks::copy_regular_bg_map_cell_offset(
-                                    source_data_ptr[index], tiles_offset, palette_offset,
-                                    destination_vram_ptr[index]);
-                    }
-                }
-                else
-                {
-                    for(int index = 0; index < half_words; ++index)
-                    {
-                        hw::bg_blocks::copy_regular_bg_map_cell_tiles_offset(
-                                    source_data_ptr[index], tiles_offset, destination_vram_ptr[index]);
-                    }
-                }
+                _commit_regular_map_region(item, tiles_offset, palette_offset, destination_vram_ptr);
             }
             else
             {
-                if(palette_offset)
-                {
-                    for(int index = 0; index < half_words; ++index)
-                    {
-                        hw::bg_blocks::copy_regular_bg_map_cell_palette_offset(
-                                    source_data_ptr[index], palette_offset, destination_vram_ptr[index]);
-                    }
-                }
-                else
-                {
-                    memory::copy(*source_data_ptr, half_words, *destination_vram_ptr);
-                }
+                _copy_regular_map_cells(source_data_ptr, item.width * item.height, tiles_offset, palette_offset,
+                                        destination_vram_ptr);
             }
         }
     }
 
+    void _set_commit(item_type& item)
+    {
+        item.commit = true;
+        item.commit_region = false;
+        data.check_commit = true;
+    }
+
     void _check_commit_item(int id, const uint16_t* data_ptr, bool delay_commit)
     {
         item_type& item = data.items.item(id);
@@ -732,15 +1058,53 @@ namespace
 
         if(delay_commit)
         {
-            item.commit = true;
-            data.check_commit = true;
+            _set_commit(item);
         }
         else
         {
+            item.commit_region = false;
             _commit_item(item);
+            item.resident = true;
         }
     }
 
+    #if BN_CFG_BG_BLOCKS_MAX_COMMIT_BYTES
+        [[nodiscard]] int _commit_bytes(const item_type& item)
+        {
+            if(item.is_tiles)
+            {
+                return item.width * 2;
+            }
+
+            if(item.is_affine)
+            {
+                // Big maps are committed from bgs_manager:
+                return _big_affine_map(item.width, item.height) ? 0 : item.width * item.height;
+            }
+
+            if(_big_regular_map(item.width, item.height))
+            {
+                // Big maps are committed from bgs_manager:
+                return 0;
+            }
+
+            if(item.commit_region)
+            {
+                int width = item.commit_max_x - item.commit_min_x + 1;
+                int height = item.commit_max_y - item.commit_min_y + 1;
+                return width * height * 2;
+            }
+
+            return item.width * item.height * 2;
+        }
+
+        [[nodiscard]] bool _queued_new_item(int id)
+        {
+            const item_type& item = data.items.item(id);
+            return item.queued && ! item.resident;
+        }
+    #endif
+
     [[nodiscard]] int _create_item(int id, int padding_blocks_count, bool delay_commit, create_data&& create_data)
     {
         item_type* item = &data.items.item(id);
@@ -817,6 +1181,7 @@ namespace
 
         const uint16_t* data_ptr = create_data.data_ptr;
         item->data = data_ptr;
+        item->reset_regular_map_item_data();
         item->blocks_count = uint8_t(blocks_count);
         item->regular_tiles = move(create_data.regular_tiles);
         item->affine_tiles = move(create_data.affine_tiles);
@@ -828,6 +1193,10 @@ namespace
         item->is_tiles = is_tiles;
         item->is_affine = create_data.is_affine;
         item->commit = false;
+        item->commit_region = false;
+        item->relocated = false;
+        item->resident = ! data_ptr;
+        item->queued = false;
 
         if(data_ptr)
         {
@@ -1019,6 +1388,251 @@ namespace
 
         return remove;
     }
+
+    [[nodiscard]] bool _relocatable(const item_type& item)
+    {
+        // Tiles and maps are uploaded again from their source data, so allocated items are skipped:
+        return item.status() == status_type::USED && item.data;
+    }
+
+    [[nodiscard]] bool _allocated_map_uses_tiles(int tiles_id)
+    {
+        for(const item_type& item : data.items)
+        {
+            if(item.status() == status_type::USED && ! item.is_tiles && ! item.data)
+            {
+                if(item.is_affine)
+                {
+                    if(item.affine_tiles && item.affine_tiles->handle() == tiles_id)
+                    {
+                        return true;
+                    }
+                }
+                else
+                {
+                    if(item.regular_tiles && item.regular_tiles->handle() == tiles_id)
+                    {
+                        return true;
+                    }
+                }
+            }
+        }
+
+        return false;
+    }
+
+    [[nodiscard]] bool _relocatable_tiles(int tiles_id, int start_block)
+    {
+        const item_type& item = data.items.item(tiles_id);
+
+        if(! item.is_tiles || ! _relocatable(item))
+        {
+            return false;
+        }
+
+        if(item.is_affine)
+        {
+            if(_padding_blocks_count<true, true>(start_block, item.blocks_count, bpp_mode::BPP_8))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            // Regular tiles BPP is not stored, so they are handled as BPP_4 tiles (the most restrictive case):
+            if(_padding_blocks_count<true, false>(start_block, item.blocks_count, bpp_mode::BPP_4))
+            {
+                return false;
+            }
+        }
+
+        // Allocated maps are not uploaded again, so the tiles offset of their cells can't be updated:
+        int alignment_blocks_count = hw::bg_blocks::tiles_alignment_blocks_count();
+
+        if(start_block % alignment_blocks_count != item.start_block % alignment_blocks_count)
+        {
+            return ! _allocated_map_uses_tiles(tiles_id);
+        }
+
+        return true;
+    }
+
+    void _set_relocated(item_type& item)
+    {
+        _set_commit(item);
+        item.relocated = true;
+    }
+
+    void _relocate_tiles(int previous_id, int free_id)
+    {
+        item_type& free_item = data.items.item(free_id);
+        int tiles_id = free_item.next_index;
+        item_type& tiles_item = data.items.item(tiles_id);
+        int old_start_block = tiles_item.start_block;
+        int new_start_block = free_item.start_block;
+        int free_blocks_count = free_item.blocks_count;
+
+        BN_BG_BLOCKS_LOG("RELOCATE TILES: ", old_start_block, " -> ", new_start_block);
+
+        // The free item is moved after the tiles, merging it with the next one if it is free too:
+        data.items.erase_after(previous_id);
+        tiles_item.start_block = uint8_t(new_start_block);
+        _set_relocated(tiles_item);
+
+        int next_id = tiles_item.next_index;
+
+        if(next_id != data.items.end().id() && data.items.item(next_id).status() == status_type::FREE)
+        {
+            item_type& next_item = data.items.item(next_id);
+            next_item.start_block -= uint8_t(free_blocks_count);
+            next_item.blocks_count += uint8_t(free_blocks_count);
+        }
+        else
+        {
+            item_type new_free_item;
+            new_free_item.start_block = uint8_t(new_start_block + tiles_item.blocks_count);
+            new_free_item.blocks_count = uint8_t(free_blocks_count);
+            data.items.insert_after(tiles_id, new_free_item);
+        }
+
+        // Maps which use the relocated tiles must update their tiles charblock and their tiles offset:
+        int alignment_blocks_count = hw::bg_blocks::tiles_alignment_blocks_count();
+        int old_tiles_cbb = old_start_block / alignment_blocks_count;
+        int new_tiles_cbb = new_start_block / alignment_blocks_count;
+        bool tiles_offset_changed = old_start_block % alignment_blocks_count !=
+                new_start_block % alignment_blocks_count;
+
+        for(item_type& item : data.items)
+        {
+            if(item.status() == status_type::USED && ! item.is_tiles)
+            {
+                if(item.is_affine)
+                {
+                    if(! item.affine_tiles || item.affine_tiles->handle() != tiles_id)
+                    {
+                        continue;
+                    }
+
+                    if(new_tiles_cbb != old_tiles_cbb)
+                    {
+                        bgs_manager::update_affine_map_tiles_cbb(item.start_block, new_tiles_cbb);
+                    }
+                }
+                else
+                {
+                    if(! item.regular_tiles || item.regular_tiles->handle() != tiles_id)
+                    {
+                        continue;
+                    }
+
+                    if(new_tiles_cbb != old_tiles_cbb)
+                    {
+                        bgs_manager::update_regular_map_tiles_cbb(item.start_block, new_tiles_cbb);
+                    }
+                }
+
+                if(tiles_offset_changed)
+                {
+                    _set_relocated(item);
+                }
+            }
+        }
+    }
+
+    void _relocate_map(int before_previous_id, int map_id, int free_id)
+    {
+        item_type& map_item = data.items.item(map_id);
+        item_type& free_item = data.items.item(free_id);
+        int old_start_block = map_item.start_block;
+        int free_blocks_count = free_item.blocks_count;
+        int new_start_block = old_start_block + free_blocks_count;
+
+        BN_BG_BLOCKS_LOG("RELOCATE MAP: ", old_start_block, " -> ", new_start_block);
+
+        // Backgrounds find their map by its start block, so they must be updated before moving it:
+        bgs_manager::update_map_sbb(old_start_block, new_start_block);
+
+        // The free item is moved before the map, merging it with the previous one if it is free too:
+        data.items.erase_after(map_id);
+        map_item.start_block = uint8_t(new_start_block);
+        _set_relocated(map_item);
+
+        item_type& before_previous_item = data.items.item(before_previous_id);
+
+        if(before_previous_id != data.items.before_begin().id() &&
+                before_previous_item.status() == status_type::FREE)
+        {
+            before_previous_item.blocks_count += uint8_t(free_blocks_count);
+        }
+        else
+        {
+            item_type new_free_item;
+            new_free_item.start_block = uint8_t(old_start_block);
+            new_free_item.blocks_count = uint8_t(free_blocks_count);
+            data.items.insert_after(before_previous_id, new_free_item);
+        }
+    }
+
+    [[nodiscard]] bool _compact()
+    {
+        // Tiles are moved to the beginning of VRAM and maps to the end, so gaps are merged between them:
+        int relocated_blocks_count = 0;
+        bool relocated = true;
+
+        while(relocated)
+        {
+            auto end = data.items.end();
+            auto before_previous_iterator = end;
+            auto previous_iterator = data.items.before_begin();
+            auto iterator = previous_iterator;
+            ++iterator;
+            relocated = false;
+
+            while(iterator != end && ! relocated)
+            {
+                if(iterator->status() == status_type::FREE)
+                {
+                    auto next_iterator = iterator;
+                    ++next_iterator;
+
+                    bool relocate_tiles = next_iterator != end &&
+                            _relocatable_tiles(next_iterator.id(), iterator->start_block);
+                    bool relocate_map = ! relocate_tiles && before_previous_iterator != end &&
+                            ! previous_iterator->is_tiles && _relocatable(*previous_iterator);
+
+                    if(relocate_tiles || relocate_map)
+                    {
+                        int blocks_count = relocate_tiles ? next_iterator->blocks_count :
+                                                            previous_iterator->blocks_count;
+
+                        if(relocated_blocks_count &&
+                                relocated_blocks_count + blocks_count > BN_CFG_BG_BLOCKS_COMPACTION_MAX_BLOCKS)
+                        {
+                            return true;
+                        }
+
+                        if(relocate_tiles)
+                        {
+                            _relocate_tiles(previous_iterator.id(), iterator.id());
+                        }
+                        else
+                        {
+                            _relocate_map(before_previous_iterator.id(), previous_iterator.id(), iterator.id());
+                        }
+
+                        relocated_blocks_count += blocks_count;
+                        relocated = true;
+                    }
+                }
+
+                before_previous_iterator = previous_iterator;
+                previous_iterator = iterator;
+                ++iterator;
+            }
+        }
+
+        return false;
+    }
 }
 
 void init()
@@ -1089,9 +1703,46 @@ int used_map_blocks_count()
     return result;
 }
 
-int available_map_blocks_count()
+int available_map_blocks_count()
+{
+    return data.free_blocks_count;
+}
+
+int queued_tiles_bytes()
+{
+    #if BN_CFG_BG_BLOCKS_MAX_COMMIT_BYTES
+        return data.queued_tiles_bytes;
+    #else
+        return 0;
+    #endif
+}
+
+int queued_map_bytes()
+{
+    #if BN_CFG_BG_BLOCKS_MAX_COMMIT_BYTES
+        return data.queued_map_bytes;
+    #else
+        return 0;
+    #endif
+}
+
+int available_contiguous_blocks_count()
+{
+    return _available_contiguous_blocks_count();
+}
+
+void compact()
+{
+    BN_BG_BLOCKS_LOG("bg_blocks_manager - COMPACT");
+
+    data.compacting = true;
+
+    BN_BG_BLOCKS_LOG_STATUS();
+}
+
+bool compacting()
 {
-    return data.free_blocks_count;
+    return data.compacting;
 }
 
 #if BN_CFG_LOG_ENABLED
@@ -1143,6 +1794,7 @@ int available_map_blocks_count()
             BN_LOG(']');
 
             BN_LOG("free_blocks_count: ", data.free_blocks_count);
+            BN_LOG("available_contiguous_blocks_count: ", _available_contiguous_blocks_count());
             BN_LOG("to_remove_blocks_count: ", data.to_remove_blocks_count);
         #endif
     }
@@ -1310,6 +1962,7 @@ int create_regular_map(const regular_bg_map_item& map_item, regular_bg_tiles_ptr
 
     if(result != -1)
     {
+        data.items.item(result).set_regular_map_item_data(map_item);
         BN_BG_BLOCKS_LOG("CREATED. start_block: ", data.items.item(result).start_block);
         BN_BG_BLOCKS_LOG_STATUS();
     }
@@ -1498,6 +2151,7 @@ int create_new_regular_map(const regular_bg_map_item& map_item, regular_bg_tiles
 
     if(result != -1)
     {
+        data.items.item(result).set_regular_map_item_data(map_item);
         BN_BG_BLOCKS_LOG("CREATED. start_block: ", data.items.item(result).start_block);
         BN_BG_BLOCKS_LOG_STATUS();
     }
@@ -1527,6 +2181,45 @@ int create_new_regular_map(const regular_bg_map_item& map_item, regular_bg_tiles
     return result;
 }
 
+int create_new_regular_map_with_tiles_cache(const regular_bg_map_item& map_item, const span<const tile>& tiles_ref,
+                                            regular_bg_tiles_ptr&& cache_tiles, bg_palette_ptr&& palette)
+{
+    #if BN_CFG_BG_BLOCKS_MAX_TILES_CACHES
+        const size& dimensions = map_item.dimensions();
+        BN_ASSERT(_big_regular_map(dimensions.width(), dimensions.height()),
+                  "Tiles caches are only supported by big maps: ", dimensions.width(), " - ", dimensions.height());
+        BN_ASSERT(! cache_tiles.tiles_ref(), "Cache tiles must be allocated");
+
+        tiles_cache_type* tiles_cache = nullptr;
+
+        for(tiles_cache_type& tiles_cache_ref : data.tiles_caches)
+        {
+            if(! tiles_cache_ref.source_tiles)
+            {
+                tiles_cache = &tiles_cache_ref;
+                break;
+            }
+        }
+
+        BN_ASSERT(tiles_cache, "No more tiles caches available");
+
+        int tiles_per_slot = palette.bpp() == bpp_mode::BPP_8 ? 2 : 1;
+        int slots_count = cache_tiles.tiles_count() / tiles_per_slot;
+        BN_ASSERT(slots_count > 0, "Invalid cache tiles count: ", cache_tiles.tiles_count(), " - ", tiles_per_slot);
+
+        tiles_cache->init(tiles_ref.data(), tiles_ref.size(), slots_count, tiles_per_slot);
+
+        int result = create_new_regular_map(map_item, move(cache_tiles), move(palette), false);
+        data.items.item(result).tiles_cache = tiles_cache;
+        return result;
+    #else
+        BN_ERROR("Tiles caches are disabled (BN_CFG_BG_BLOCKS_MAX_TILES_CACHES is 0): ",
+                 &map_item.cells_ref(), " - ", tiles_ref.size(), " - ", cache_tiles.id(), " - ", palette.id());
+
+        return -1;
+    #endif
+}
+
 int create_new_affine_map(const affine_bg_map_item& map_item, affine_bg_tiles_ptr&& tiles,
                           bg_palette_ptr&& palette, bool optional)
 {
@@ -1828,7 +2521,8 @@ optional<span<const regular_bg_map_cell>> regular_map_cells_ref(int id)
 
     if(const uint16_t* item_data = item.data)
     {
-        result.emplace(item_data, item.width * item.height);
+        int shift = item.metatile_shift;
+        result.emplace(item_data, (item.width >> shift) * (item.height >> shift));
     }
 
     return result;
@@ -1908,6 +2602,8 @@ void set_regular_map_cells_ref(int id, const regular_bg_map_item& map_item)
     item_type& item = data.items.item(id);
     BN_ASSERT(item.data, "Item has no data");
 
+    item.set_regular_map_item_data(map_item);
+
     if(item.data != data_ptr)
     {
         BN_ASSERT(data.items_map.find(data_ptr) == data.items_map.end(),
@@ -1950,8 +2646,44 @@ void reload(int id)
     item_type& item = data.items.item(id);
     BN_ASSERT(item.data, "Item has no data");
 
-    item.commit = true;
-    data.check_commit = true;
+    _set_commit(item);
+
+    BN_BG_BLOCKS_LOG_STATUS();
+}
+
+void reload_regular_map_region(int id, int x, int y, int width, int height)
+{
+    BN_BG_BLOCKS_LOG("bg_blocks_manager - RELOAD REGULAR MAP REGION: ", id, " - ", x, " - ", y, " - ",
+                     width, " - ", height);
+
+    item_type& item = data.items.item(id);
+    BN_ASSERT(item.data, "Item has no data");
+    BN_ASSERT(x >= 0 && y >= 0 && width > 0 && height > 0 && x + width <= item.width && y + height <= item.height,
+              "Invalid region: ", x, " - ", y, " - ", width, " - ", height, " - ", item.width, " - ", item.height);
+
+    if(_big_regular_map(item.width, item.height))
+    {
+        // Big maps are committed from bgs_manager:
+        _set_commit(item);
+    }
+    else if(! item.commit)
+    {
+        item.commit = true;
+        item.commit_region = true;
+        item.commit_min_x = uint8_t(x);
+        item.commit_min_y = uint8_t(y);
+        item.commit_max_x = uint8_t(x + width - 1);
+        item.commit_max_y = uint8_t(y + height - 1);
+        data.check_commit = true;
+    }
+    else if(item.commit_region)
+    {
+        // Pending regions are merged into their bounding rectangle:
+        item.commit_min_x = uint8_t(min(int(item.commit_min_x), x));
+        item.commit_min_y = uint8_t(min(int(item.commit_min_y), y));
+        item.commit_max_x = uint8_t(max(int(item.commit_max_x), x + width - 1));
+        item.commit_max_y = uint8_t(max(int(item.commit_max_y), y + height - 1));
+    }
 
     BN_BG_BLOCKS_LOG_STATUS();
 }
@@ -1972,6 +2704,10 @@ void set_regular_map_tiles(int id, regular_bg_tiles_ptr&& tiles)
 {
     item_type& item = data.items.item(id);
 
+    #if BN_CFG_BG_BLOCKS_MAX_TILES_CACHES
+        BN_ASSERT(! item.tiles_cache, "Maps with a tiles cache don't support tiles change");
+    #endif
+
     if(tiles != item.regular_tiles)
     {
         BN_ASSERT(regular_bg_tiles_item::valid_tiles_count(tiles.tiles_count(), item.palette->bpp()),
@@ -2002,8 +2738,7 @@ void set_regular_map_tiles(int id, regular_bg_tiles_ptr&& tiles)
 
         if(item.regular_tiles_offset() != old_tiles_offset)
         {
-            item.commit = true;
-            data.check_commit = true;
+            _set_commit(item);
         }
     }
 }
@@ -2039,8 +2774,7 @@ void set_affine_map_tiles(int id, affine_bg_tiles_ptr&& tiles)
 
         if(item.affine_tiles_offset() != old_tiles_offset)
         {
-            item.commit = true;
-            data.check_commit = true;
+            _set_commit(item);
         }
     }
 }
@@ -2099,8 +2833,7 @@ void set_regular_map_palette(int id, bg_palette_ptr&& palette)
 
         if(item.regular_tiles_offset() != old_tiles_offset || item.palette_offset() != old_palette_offset)
         {
-            item.commit = true;
-            data.check_commit = true;
+            _set_commit(item);
         }
     }
 }
@@ -2126,6 +2859,10 @@ void remove_map_palette(int id)
 void set_regular_map_tiles_and_palette(int id, regular_bg_tiles_ptr&& tiles, bg_palette_ptr&& palette)
 {
     item_type& item = data.items.item(id);
+
+    #if BN_CFG_BG_BLOCKS_MAX_TILES_CACHES
+        BN_ASSERT(! item.tiles_cache, "Maps with a tiles cache don't support tiles change");
+    #endif
     bpp_mode new_palette_bpp = palette.bpp();
     BN_ASSERT(regular_bg_tiles_item::valid_tiles_count(tiles.tiles_count(), new_palette_bpp),
               "Invalid tiles count or palette BPP: ", tiles.tiles_count(), " - ", int(new_palette_bpp));
@@ -2171,8 +2908,7 @@ void set_regular_map_tiles_and_palette(int id, regular_bg_tiles_ptr&& tiles, bg_
 
     if(item.regular_tiles_offset() != old_tiles_offset || item.palette_offset() != old_palette_offset)
     {
-        item.commit = true;
-        data.check_commit = true;
+        _set_commit(item);
     }
 }
 
@@ -2224,6 +2960,30 @@ bool must_commit(int id)
     return item.commit;
 }
 
+bool queued([[maybe_unused]] int id)
+{
+    #if BN_CFG_BG_BLOCKS_MAX_COMMIT_BYTES
+        if(_queued_new_item(id))
+        {
+            return true;
+        }
+
+        const item_type& item = data.items.item(id);
+
+        if(item.regular_tiles)
+        {
+            return _queued_new_item(item.regular_tiles->handle());
+        }
+
+        if(item.affine_tiles)
+        {
+            return _queued_new_item(item.affine_tiles->handle());
+        }
+    #endif
+
+    return false;
+}
+
 void update_regular_map_col(int id, int x, int y)
 {
     const item_type& item = data.items.item(id);
@@ -2237,88 +2997,67 @@ void update_regular_map_col(int id, int x, int y)
     BN_ASSERT(x >= 0 && x < item.width, "Invalid x: ", x, " - ", item.width);
     BN_ASSERT(y >= 0 && y < item.height, "Invalid y: ", y, " - ", item.height);
 
-    int map_width = item.width;
-    source_data += ((y * map_width) + x);
-
-    int y_separator = y & 31;
-    uint16_t* dest_data = hw::bg_blocks::vram(item.start_block) + ((y_separator * 32) + (x & 31));
+    int source_stride = item.width;
+    alignas(int) uint16_t column_cells[32];
 
-    if(auto tiles_offset = unsigned(item.regular_tiles_offset()))
+    if(const uint16_t* column_major_data = item.column_major_data)
     {
-        if(auto palette_offset = unsigned(item.palette_offset()))
-        {
-            for(int iy = y_separator; iy < 32; ++iy)
-            {
-                hw::bg_blocks::copy_regular_bg_map_cell_offset(*source_data, tiles_offset, palette_offset, *dest_data);
-                dest_data += 32;
-                source_data += map_width;
-            }
-
-            dest_data -= 1024;
+        // Column cells are contiguous in the column-major copy, so they are read in one go:
+        memory::copy(column_major_data[(x * item.height) + y], 32, column_cells[0]);
+        source_data = column_cells;
+        source_stride = 1;
+    }
+    else if(item.metatiles_data)
+    {
+        _expand_regular_metatiles_col(item, x, y, column_cells);
+        source_data = column_cells;
+        source_stride = 1;
+    }
+    else
+    {
+        source_data += ((y * source_stride) + x);
+    }
 
-            for(int iy = 0; iy < y_separator; ++iy)
-            {
-                hw::bg_blocks::copy_regular_bg_map_cell_offset(*source_data, tiles_offset, palette_offset, *dest_data);
-                dest_data += 32;
-                source_data += map_width;
-            }
-        }
-        else
+    #if BN_CFG_BG_BLOCKS_MAX_TILES_CACHES
+        if(item.tiles_cache)
         {
-            for(int iy = y_separator; iy < 32; ++iy)
-            {
-                hw::bg_blocks::copy_regular_bg_map_cell_tiles_offset(*source_data, tiles_offset, *dest_data);
-                dest_data += 32;
-                source_data += map_width;
-            }
+            _cache_regular_map_col(item, x, y, source_data, source_stride, column_cells);
+            source_data = column_cells;
+            source_stride = 1;
+        }
+    #endif
 
-            dest_data -= 1024;
+    int y_separator = y & 31;
+    int elements = 32 - y_separator;
+    uint16_t* dest_data = hw::bg_blocks::vram(item.start_block) + ((y_separator * 32) + (x & 31));
+    auto tiles_offset = unsigned(item.regular_tiles_offset());
+    auto palette_offset = unsigned(item.palette_offset());
 
-            for(int iy = 0; iy < y_separator; ++iy)
-            {
-                hw::bg_blocks::copy_regular_bg_map_cell_tiles_offset(*source_data, tiles_offset, *dest_data);
-                dest_data += 32;
-                source_data += map_width;
-            }
-        }
+    if(tiles_offset || palette_offset)
+    {
+        hw::bg_blocks::copy_regular_bg_map_col_offset(source_data, source_stride, elements, tiles_offset,
+                                                      palette_offset, dest_data);
+        source_data += elements * source_stride;
+        dest_data -= y_separator * 32;
+        hw::bg_blocks::copy_regular_bg_map_col_offset(source_data, source_stride, y_separator, tiles_offset,
+                                                      palette_offset, dest_data);
     }
     else
     {
-        if(auto palette_offset = unsigned(item.palette_offset()))
+        for(int iy = y_separator; iy < 32; ++iy)
         {
-            for(int iy = y_separator; iy < 32; ++iy)
-            {
-                hw::bg_blocks::copy_regular_bg_map_cell_palette_offset(*source_data, palette_offset, *dest_data);
-                dest_data += 32;
-                source_data += map_width;
-            }
-
-            dest_data -= 1024;
-
-            for(int iy = 0; iy < y_separator; ++iy)
-            {
-                hw::bg_blocks::copy_regular_bg_map_cell_palette_offset(*source_data, palette_offset, *dest_data);
-                dest_data += 32;
-                source_data += map_width;
-            }
+            *dest_data = *source_data;
+            dest_data += 32;
+            source_data += source_stride;
         }
-        else
-        {
-            for(int iy = y_separator; iy < 32; ++iy)
-            {
-                *dest_data = *source_data;
-                dest_data += 32;
-                source_data += map_width;
-            }
 
-            dest_data -= 1024;
+        dest_data -= 1024;
 
-            for(int iy = 0; iy < y_separator; ++iy)
-            {
-                *dest_data = *source_data;
-                dest_data += 32;
-                source_data += map_width;
-            }
+        for(int iy = 0; iy < y_separator; ++iy)
+        {
+            *dest_data = *source_data;
+            dest_data += 32;
+            source_data += source_stride;
         }
     }
 }
@@ -2452,79 +3191,33 @@ void update_regular_map_row(int id, int x, int y)
     BN_ASSERT(x >= 0 && x < item.width, "Invalid x: ", x, " - ", item.width);
     BN_ASSERT(y >= 0 && y < item.height, "Invalid y: ", y, " - ", item.height);
 
-    source_data += ((y * item.width) + x);
-
-    int x_separator = x & 31;
-    uint16_t* dest_data = hw::bg_blocks::vram(item.start_block) + (((y & 31) * 32) + x_separator);
+    alignas(int) uint16_t row_cells[32];
 
-    if(auto tiles_offset = unsigned(item.regular_tiles_offset()))
+    if(item.metatiles_data)
     {
-        if(auto palette_offset = unsigned(item.palette_offset()))
-        {
-            for(int ix = x_separator; ix < 32; ++ix)
-            {
-                hw::bg_blocks::copy_regular_bg_map_cell_offset(*source_data, tiles_offset, palette_offset, *dest_data);
-                ++source_data;
-                ++dest_data;
-            }
-
-            dest_data -= 32;
-
-            for(int ix = 0; ix < x_separator; ++ix)
-            {
-                hw::bg_blocks::copy_regular_bg_map_cell_offset(*source_data, tiles_offset, palette_offset, *dest_data);
-                ++source_data;
-                ++dest_data;
-            }
-        }
-        else
-        {
-            for(int ix = x_separator; ix < 32; ++ix)
-            {
-                hw::bg_blocks::copy_regular_bg_map_cell_tiles_offset(*source_data, tiles_offset, *dest_data);
-                ++source_data;
-                ++dest_data;
-            }
-
-            dest_data -= 32;
-
-            for(int ix = 0; ix < x_separator; ++ix)
-            {
-                hw::bg_blocks::copy_regular_bg_map_cell_tiles_offset(*source_data, tiles_offset, *dest_data);
-                ++source_data;
-                ++dest_data;
-            }
-        }
+        _expand_regular_metatiles_row(item, x, y, row_cells);
+        source_data = row_cells;
     }
     else
     {
-        if(auto palette_offset = unsigned(item.palette_offset()))
-        {
-            for(int ix = x_separator; ix < 32; ++ix)
-            {
-                hw::bg_blocks::copy_regular_bg_map_cell_palette_offset(*source_data, palette_offset, *dest_data);
-                ++source_data;
-                ++dest_data;
-            }
-
-            dest_data -= 32;
+        source_data += ((y * item.width) + x);
+    }
 
-            for(int ix = 0; ix < x_separator; ++ix)
-            {
-                hw::bg_blocks::copy_regular_bg_map_cell_palette_offset(*source_data, palette_offset, *dest_data);
-                ++source_data;
-                ++dest_data;
-            }
-        }
-        else
+    #if BN_CFG_BG_BLOCKS_MAX_TILES_CACHES
+        if(item.tiles_cache)
         {
-            int elements = 32 - x_separator;
-            memory::copy(*source_data, elements, *dest_data);
-            source_data += elements;
-            dest_data -= x_separator;
-            memory::copy(*source_data, x_separator, *dest_data);
+            _cache_regular_map_row(item, x, y, source_data, row_cells);
+            source_data = row_cells;
         }
-    }
+    #endif
+
+    int x_separator = x & 31;
+    int elements = 32 - x_separator;
+    uint16_t* dest_data = hw::bg_blocks::vram(item.start_block) + ((y & 31) * 32);
+    auto tiles_offset = unsigned(item.regular_tiles_offset());
+    auto palette_offset = unsigned(item.palette_offset());
+    _copy_regular_map_cells(source_data, elements, tiles_offset, palette_offset, dest_data + x_separator);
+    _copy_regular_map_cells(source_data + elements, x_separator, tiles_offset, palette_offset, dest_data);
 }
 
 void update_affine_map_row(int id, int x, int y)
@@ -2591,102 +3284,36 @@ void set_regular_map_position(int id, int x, int y)
     BN_ASSERT(x >= 0 && x < item.width, "Invalid x: ", x, " - ", item.width);
     BN_ASSERT(y >= 0 && y < item.height, "Invalid y: ", y, " - ", item.height);
 
-    uint16_t* vram_data = hw::bg_blocks::vram(item.start_block);
-    int map_width = item.width;
-    int x_separator = x & 31;
+    bool rows_update = item.metatiles_data != nullptr;
+
+    #if BN_CFG_BG_BLOCKS_MAX_TILES_CACHES
+        rows_update |= item.tiles_cache != nullptr;
+    #endif
 
-    if(auto tiles_offset = unsigned(item.regular_tiles_offset()))
+    if(rows_update)
     {
-        if(auto palette_offset = unsigned(item.palette_offset()))
+        // Metatiles are expanded and cached tiles are remapped row by row:
+        for(int row = y, row_limit = y + 22; row < row_limit; ++row)
         {
-            for(int row = y, row_limit = y + 22; row < row_limit; ++row)
-            {
-                const uint16_t* source_data = item_data + ((row * map_width) + x);
-                uint16_t* dest_data = vram_data + (((row & 31) * 32) + x_separator);
-
-                for(int ix = x_separator; ix < 32; ++ix)
-                {
-                    hw::bg_blocks::copy_regular_bg_map_cell_offset(*source_data, tiles_offset, palette_offset,
-                                                                   *dest_data);
-                    ++source_data;
-                    ++dest_data;
-                }
-
-                dest_data -= 32;
-
-                for(int ix = 0; ix < x_separator; ++ix)
-                {
-                    hw::bg_blocks::copy_regular_bg_map_cell_offset(*source_data, tiles_offset, palette_offset,
-                                                                   *dest_data);
-                    ++source_data;
-                    ++dest_data;
-                }
-            }
+            update_regular_map_row(id, x, row);
         }
-        else
-        {
-            for(int row = y, row_limit = y + 22; row < row_limit; ++row)
-            {
-                const uint16_t* source_data = item_data + ((row * map_width) + x);
-                uint16_t* dest_data = vram_data + (((row & 31) * 32) + x_separator);
-
-                for(int ix = x_separator; ix < 32; ++ix)
-                {
-                    hw::bg_blocks::copy_regular_bg_map_cell_tiles_offset(*source_data, tiles_offset, *dest_data);
-                    ++source_data;
-                    ++dest_data;
-                }
-
-                dest_data -= 32;
 
-                for(int ix = 0; ix < x_separator; ++ix)
-                {
-                    hw::bg_blocks::copy_regular_bg_map_cell_tiles_offset(*source_data, tiles_offset, *dest_data);
-                    ++source_data;
-                    ++dest_data;
-                }
-            }
-        }
+        return;
     }
-    else
-    {
-        if(auto palette_offset = unsigned(item.palette_offset()))
-        {
-            for(int row = y, row_limit = y + 22; row < row_limit; ++row)
-            {
-                const uint16_t* source_data = item_data + ((row * map_width) + x);
-                uint16_t* dest_data = vram_data + (((row & 31) * 32) + x_separator);
-
-                for(int ix = x_separator; ix < 32; ++ix)
-                {
-                    hw::bg_blocks::copy_regular_bg_map_cell_palette_offset(*source_data, palette_offset, *dest_data);
-                    ++source_data;
-                    ++dest_data;
-                }
 
-                dest_data -= 32;
+    uint16_t* vram_data = hw::bg_blocks::vram(item.start_block);
+    int map_width = item.width;
+    int x_separator = x & 31;
+    int elements = 32 - x_separator;
+    auto tiles_offset = unsigned(item.regular_tiles_offset());
+    auto palette_offset = unsigned(item.palette_offset());
 
-                for(int ix = 0; ix < x_separator; ++ix)
-                {
-                    hw::bg_blocks::copy_regular_bg_map_cell_palette_offset(*source_data, palette_offset, *dest_data);
-                    ++source_data;
-                    ++dest_data;
-                }
-            }
-        }
-        else
-        {
-            for(int row = y, row_limit = y + 22; row < row_limit; ++row)
-            {
-                const uint16_t* source_data = item_data + ((row * map_width) + x);
-                uint16_t* dest_data = vram_data + (((row & 31) * 32) + x_separator);
-                int elements = 32 - x_separator;
-                memory::copy(*source_data, elements, *dest_data);
-                source_data += elements;
-                dest_data -= x_separator;
-                memory::copy(*source_data, x_separator, *dest_data);
-            }
-        }
+    for(int row = y, row_limit = y + 22; row < row_limit; ++row)
+    {
+        const uint16_t* source_data = item_data + ((row * map_width) + x);
+        uint16_t* dest_data = vram_data + ((row & 31) * 32);
+        _copy_regular_map_cells(source_data, elements, tiles_offset, palette_offset, dest_data + x_separator);
+        _copy_regular_map_cells(source_data + elements, x_separator, tiles_offset, palette_offset, dest_data);
     }
 }
 
@@ -2774,10 +3401,12 @@ void update()
                 }
 
                 item.data = nullptr;
+                item.reset_regular_map_item_data();
                 item.width = 0;
                 item.height = 0;
                 item.set_status(status_type::FREE);
                 item.commit = false;
+                item.commit_region = false;
                 data.free_blocks_count += item.blocks_count;
 
                 auto next_iterator = iterator;
@@ -2811,8 +3440,82 @@ void update()
             ++iterator;
         }
 
+        data.check_compaction = true;
+
+        BN_BG_BLOCKS_LOG_STATUS();
+    }
+}
+
+void prepare_commit()
+{
+    #if BN_CFG_BG_BLOCKS_COMPACTION_THRESHOLD
+        if(data.check_compaction)
+        {
+            constexpr int threshold = BN_CFG_BG_BLOCKS_COMPACTION_THRESHOLD;
+
+            if(data.free_blocks_count >= threshold && _available_contiguous_blocks_count() < threshold)
+            {
+                data.compacting = true;
+            }
+        }
+    #endif
+
+    data.check_compaction = false;
+
+    if(data.compacting)
+    {
+        BN_BG_BLOCKS_LOG("bg_blocks_manager - PREPARE_COMMIT COMPACTION");
+
+        data.compacting = _compact();
+
         BN_BG_BLOCKS_LOG_STATUS();
     }
+
+    #if BN_CFG_BG_BLOCKS_MAX_COMMIT_BYTES
+        data.queued_tiles_bytes = 0;
+        data.queued_map_bytes = 0;
+
+        if(data.check_commit)
+        {
+            int available_bytes = BN_CFG_BG_BLOCKS_MAX_COMMIT_BYTES;
+            bool empty = true;
+
+            // Blocks already in VRAM are uploaded before new ones, since they are already displayed:
+            for(int pass = 0; pass < 2; ++pass)
+            {
+                bool resident = pass == 0;
+
+                for(item_type& item : data.items)
+                {
+                    if(item.commit && item.resident == resident && item.status() == status_type::USED)
+                    {
+                        int bytes = _commit_bytes(item);
+
+                        // Relocated items must be uploaded in the same V-Blank as the backgrounds are updated:
+                        if(item.relocated || empty || bytes <= available_bytes)
+                        {
+                            available_bytes -= bytes;
+                            item.queued = false;
+                            empty = empty && ! bytes;
+                        }
+                        else
+                        {
+                            item.queued = true;
+
+                            if(item.is_tiles)
+                            {
+                                data.queued_tiles_bytes += bytes;
+                            }
+                            else
+                            {
+                                data.queued_map_bytes += bytes;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    #endif
 }
 
 void commit()
@@ -2829,12 +3532,24 @@ void commit()
         {
             if(item.commit)
             {
+                #if BN_CFG_BG_BLOCKS_MAX_COMMIT_BYTES
+                    if(item.queued && item.status() == status_type::USED)
+                    {
+                        data.check_commit = true;
+                        continue;
+                    }
+                #endif
+
                 item.commit = false;
 
                 if(item.status() == status_type::USED)
                 {
                     _commit_item(item);
+                    item.resident = true;
                 }
+
+                item.commit_region = false;
+                item.relocated = false;
             }
         }
     }
@@ -46,6 +46,16 @@ namespace bn::bg_blocks_manager
 
     [[nodiscard]] int available_map_blocks_count();
 
+    [[nodiscard]] int queued_tiles_bytes();
+
+    [[nodiscard]] int queued_map_bytes();
+
+    [[nodiscard]] int available_contiguous_blocks_count();
+
+    void compact();
+
+    [[nodiscard]] bool compacting();
+
     #if BN_CFG_LOG_ENABLED
         void log_status();
     #endif
@@ -80,6 +90,10 @@ namespace bn::bg_blocks_manager
     [[nodiscard]] int create_new_affine_map(const affine_bg_map_item& map_item, affine_bg_tiles_ptr&& tiles,
                                             bg_palette_ptr&& palette, bool optional);
 
+    [[nodiscard]] int create_new_regular_map_with_tiles_cache(
+            const regular_bg_map_item& map_item, const span<const tile>& tiles_ref,
+            regular_bg_tiles_ptr&& cache_tiles, bg_palette_ptr&& palette);
+
     [[nodiscard]] int allocate_regular_tiles(int tiles_count, bpp_mode bpp, bool optional);
 
     [[nodiscard]] int allocate_affine_tiles(int tiles_count, bool optional);
@@ -124,6 +138,8 @@ namespace bn::bg_blocks_manager
 
     void reload(int id);
 
+    void reload_regular_map_region(int id, int x, int y, int width, int height);
+
     [[nodiscard]] const regular_bg_tiles_ptr& regular_map_tiles(int id);
 
     [[nodiscard]] const affine_bg_tiles_ptr& affine_map_tiles(int id);
@@ -154,6 +170,8 @@ namespace bn::bg_blocks_manager
 
     [[nodiscard]] bool must_commit(int id);
 
+    [[nodiscard]] bool queued(int id);
+
     void update_regular_map_col(int id, int x, int y);
 
     void update_affine_map_col(int id, int x, int y);
@@ -168,6 +186,8 @@ namespace bn::bg_blocks_manager
 
     void update();
 
+    void prepare_commit();
+
     void commit();
 }
 
@@ -30,6 +30,26 @@ int available_blocks_count()
     return bg_blocks_manager::available_map_blocks_count();
 }
 
+int queued_bytes()
+{
+    return bg_blocks_manager::queued_map_bytes();
+}
+
+int available_contiguous_blocks_count()
+{
+    return bg_blocks_manager::available_contiguous_blocks_count();
+}
+
+void compact()
+{
+    bg_blocks_manager::compact();
+}
+
+bool compacting()
+{
+    return bg_blocks_manager::compacting();
+}
+
 #if BN_CFG_LOG_ENABLED
     void log_status()
     {
@@ -20,4 +20,24 @@ int available_items_count()
     return bgs_manager::available_count();
 }
 
+big_map_redraw_mode big_maps_redraw_mode()
+{
+    return bgs_manager::big_maps_redraw_mode();
+}
+
+void set_big_maps_redraw_mode(big_map_redraw_mode redraw_mode)
+{
+    bgs_manager::set_big_maps_redraw_mode(redraw_mode);
+}
+
+bool big_maps_redrawing()
+{
+    return bgs_manager::big_maps_redraw_pending_rows() > 0;
+}
+
+int big_maps_redraw_pending_rows()
+{
+    return bgs_manager::big_maps_redraw_pending_rows();
+}
+
 }
@@ -11,6 +11,10 @@
 #include "bn_display.h"
 #include "bn_sort_key.h"
 #include "bn_config_bgs.h"
+#include "bn_config_bg_blocks.h"
+#include "bn_config_cameras.h"
+#include "bn_intrusive_list.h"
+#include "bn_big_map_redraw_mode.h"
 #include "bn_display_manager.h"
 #include "bn_bg_blocks_manager.h"
 #include "bn_affine_bg_mat_attributes.h"
@@ -32,8 +36,9 @@ namespace bn::bgs_manager
 namespace
 {
     static_assert(BN_CFG_BGS_MAX_ITEMS > 0);
+    static_assert(BN_CFG_BGS_BIG_MAPS_REDRAW_ROWS > 0);
 
-    class item_type
+    class item_type : public intrusive_list_node_type
     {
 
     public:
@@ -50,12 +55,15 @@ namespace
         uint16_t old_big_map_x = 0;
         uint16_t old_big_map_y = 0;
         int8_t handles_index = -1;
+        int8_t redraw_begin_row = 0;
+        int8_t redraw_end_row = 0;
         bool blending_enabled: 1;
         bool visible: 1;
         bool update: 1;
         bool big_map: 1;
         bool commit_big_map: 1;
         bool full_commit_big_map: 1;
+        bool hidden: 1;
 
         item_type(regular_bg_builder&& builder, regular_bg_map_ptr&& _regular_map) :
             position(builder.position()),
@@ -64,7 +72,8 @@ namespace
             camera(builder.release_camera()),
             blending_enabled(builder.blending_enabled()),
             visible(builder.visible()),
-            update(true)
+            update(true),
+            hidden(false)
         {
             hw::bgs::setup_regular(builder, handle);
             update_regular_map();
@@ -79,7 +88,8 @@ namespace
             camera(builder.release_camera()),
             blending_enabled(builder.blending_enabled()),
             visible(builder.visible()),
-            update(true)
+            update(true),
+            hidden(false)
         {
             hw::bgs::setup_affine(builder, handle);
             update_affine_map(true);
@@ -279,6 +289,53 @@ namespace
             return point(map_x2, map_y2);
         }
 
+        [[nodiscard]] point big_map_position() const
+        {
+            int map_x;
+            int map_y;
+
+            if(regular_map)
+            {
+                map_x = hw_position.x() >> 3;
+                map_y = hw_position.y() >> 3;
+            }
+            else
+            {
+                point map_position = affine_map_position();
+                map_x = map_position.x();
+                map_y = map_position.y();
+
+                if(map_x % 2)
+                {
+                    --map_x;
+                }
+            }
+
+            map_x = min(map_x, (half_dimensions.width() / 4) - 32);
+            map_y = min(map_y, (half_dimensions.height() / 4) - 22);
+            return point(map_x, map_y);
+        }
+
+        [[nodiscard]] bool big_map_redraw_pending() const
+        {
+            if(big_map)
+            {
+                if(redraw_begin_row < redraw_end_row)
+                {
+                    return true;
+                }
+
+                if(commit_big_map && ! full_commit_big_map)
+                {
+                    point map_position = big_map_position();
+                    return bn::abs(map_position.x() - old_big_map_x) > 8 ||
+                            bn::abs(map_position.y() - old_big_map_y) > 8;
+                }
+            }
+
+            return false;
+        }
+
         void update_affine_hw_x()
         {
             int dx = affine_mat_attributes.dx_register_value();
@@ -343,9 +400,12 @@ namespace
     public:
         pool<item_type, BN_CFG_BGS_MAX_ITEMS> items_pool;
         vector<item_type*, BN_CFG_BGS_MAX_ITEMS> items_vector;
+        intrusive_list<item_type> camera_items[BN_CFG_CAMERA_MAX_ITEMS];
         hw::bgs::handle handles[hw::bgs::count()];
+        big_map_redraw_mode big_maps_redraw_mode = big_map_redraw_mode::IMMEDIATE;
         bool rebuild_handles = false;
         bool commit = false;
+        bool hidden_bgs = false;
     };
 
     BN_DATA_EWRAM static_data data;
@@ -407,6 +467,22 @@ namespace
         data.items_vector.push_back(&new_item);
     }
 
+    void _attach_camera(item_type& item)
+    {
+        if(const optional<camera_ptr>& camera = item.camera)
+        {
+            data.camera_items[camera->id()].push_back(item);
+        }
+    }
+
+    void _dettach_camera(item_type& item)
+    {
+        if(const optional<camera_ptr>& camera = item.camera)
+        {
+            data.camera_items[camera->id()].erase(item);
+        }
+    }
+
     void _update_item(const item_type& item)
     {
         if(! data.rebuild_handles && item.visible)
@@ -427,6 +503,28 @@ int available_count()
     return data.items_vector.available();
 }
 
+big_map_redraw_mode big_maps_redraw_mode()
+{
+    return data.big_maps_redraw_mode;
+}
+
+void set_big_maps_redraw_mode(big_map_redraw_mode redraw_mode)
+{
+    data.big_maps_redraw_mode = redraw_mode;
+}
+
+int big_maps_redraw_pending_rows()
+{
+    int result = 0;
+
+    for(const item_type* item : data.items_vector)
+    {
+        result += item->redraw_end_row - item->redraw_begin_row;
+    }
+
+    return result;
+}
+
 id_type create(regular_bg_builder&& builder)
 {
     BN_ASSERT(! data.items_vector.full(), "No more available BGs");
@@ -436,6 +534,7 @@ id_type create(regular_bg_builder&& builder)
     BN_ASSERT(_check_unique_regular_big_map(item), "Two or more regular BGs have the same big map");
 
     _insert_item(item);
+    _attach_camera(item);
     display_manager::set_show_bg_in_all_windows(&item, true);
     return &item;
 }
@@ -449,6 +548,7 @@ id_type create(affine_bg_builder&& builder)
     BN_ASSERT(_check_unique_affine_big_map(item), "Two or more affine BGs have the same big map");
 
     _insert_item(item);
+    _attach_camera(item);
     display_manager::set_show_bg_in_all_windows(&item, true);
     return &item;
 }
@@ -471,6 +571,7 @@ id_type create_optional(regular_bg_builder&& builder)
     BN_ASSERT(_check_unique_regular_big_map(item), "Two or more regular BGs have the same big map");
 
     _insert_item(item);
+    _attach_camera(item);
     display_manager::set_show_bg_in_all_windows(&item, true);
     return &item;
 }
@@ -493,6 +594,7 @@ id_type create_optional(affine_bg_builder&& builder)
     BN_ASSERT(_check_unique_affine_big_map(item), "Two or more affine BGs have the same big map");
 
     _insert_item(item);
+    _attach_camera(item);
     display_manager::set_show_bg_in_all_windows(&item, true);
     return &item;
 }
@@ -524,6 +626,7 @@ void decrease_usages(id_type id)
 
         display_manager::set_show_bg_in_all_windows(item, false);
         erase(data.items_vector, item);
+        _dettach_camera(*item);
         data.items_pool.destroy(*item);
     }
 }
@@ -1135,7 +1238,9 @@ void set_camera(id_type id, camera_ptr&& camera)
 
     if(camera != item->camera)
     {
+        _dettach_camera(*item);
         item->camera = move(camera);
+        _attach_camera(*item);
 
         if(item->regular_map)
         {
@@ -1156,6 +1261,7 @@ void remove_camera(id_type id)
 
     if(item->camera)
     {
+        _dettach_camera(*item);
         item->camera.reset();
 
         if(item->regular_map)
@@ -1171,23 +1277,20 @@ void remove_camera(id_type id)
     }
 }
 
-void update_cameras()
+void update_camera(int camera_id)
 {
-    for(item_type* item : data.items_vector)
+    for(item_type& item : data.camera_items[camera_id])
     {
-        if(item->camera)
+        if(item.regular_map)
         {
-            if(item->regular_map)
-            {
-                item->update_regular_hw_position();
-            }
-            else
-            {
-                item->update_affine_camera();
-            }
-
-            _update_item(*item);
+            item.update_regular_hw_position();
+        }
+        else
+        {
+            item.update_affine_camera();
         }
+
+        _update_item(item);
     }
 }
 
@@ -1195,7 +1298,7 @@ void update_regular_map_tiles_cbb(int map_id, int tiles_cbb)
 {
     for(item_type* item : data.items_vector)
     {
-        if(item->regular_map->id() == map_id)
+        if(item->regular_map && item->regular_map->id() == map_id)
         {
             hw::bgs::set_tiles_cbb(tiles_cbb, item->handle);
             _update_item(*item);
@@ -1207,7 +1310,7 @@ void update_affine_map_tiles_cbb(int map_id, int tiles_cbb)
 {
     for(item_type* item : data.items_vector)
     {
-        if(item->affine_map->id() == map_id)
+        if(item->affine_map && item->affine_map->id() == map_id)
         {
             hw::bgs::set_tiles_cbb(tiles_cbb, item->handle);
             _update_item(*item);
@@ -1219,7 +1322,7 @@ void update_regular_map_palette_bpp(int map_id, bpp_mode bpp)
 {
     for(item_type* item : data.items_vector)
     {
-        if(item->regular_map->id() == map_id)
+        if(item->regular_map && item->regular_map->id() == map_id)
         {
             hw::bgs::set_bpp(bpp, item->handle);
             _update_item(*item);
@@ -1227,6 +1330,20 @@ void update_regular_map_palette_bpp(int map_id, bpp_mode bpp)
     }
 }
 
+void update_map_sbb(int old_map_id, int new_map_id)
+{
+    for(item_type* item : data.items_vector)
+    {
+        int map_id = item->regular_map ? item->regular_map->id() : item->affine_map->id();
+
+        if(map_id == old_map_id)
+        {
+            hw::bgs::set_map_sbb(new_map_id, item->handle);
+            _update_item(*item);
+        }
+    }
+}
+
 void reload()
 {
     data.commit = true;
@@ -1361,6 +1478,7 @@ void update()
 
                 item->handles_index = int8_t(id);
                 data.handles[id] = item->handle;
+                item->hidden = false;
                 display_manager::set_bg_enabled(id, true);
                 display_manager::set_blending_bg_enabled(id, item->blending_enabled);
                 --id;
@@ -1388,6 +1506,48 @@ void update()
     }
 }
 
+void prepare_commit()
+{
+    #if BN_CFG_BG_BLOCKS_MAX_COMMIT_BYTES
+        // BGs with tiles or maps queued for the next V-Blanks are hidden until they are uploaded:
+        bool queued_blocks = bg_blocks_manager::queued_tiles_bytes() || bg_blocks_manager::queued_map_bytes();
+    #else
+        bool queued_blocks = false;
+    #endif
+
+    // Big maps redrawn over several V-Blanks can be hidden until their visible area is complete:
+    bool redraw_hidden = data.big_maps_redraw_mode == big_map_redraw_mode::PROGRESSIVE_HIDDEN;
+
+    if(queued_blocks || redraw_hidden || data.hidden_bgs)
+    {
+        data.hidden_bgs = false;
+
+        for(item_type* item : data.items_vector)
+        {
+            if(item->handles_index >= 0)
+            {
+                bool hide = redraw_hidden && item->big_map_redraw_pending();
+
+                #if BN_CFG_BG_BLOCKS_MAX_COMMIT_BYTES
+                    if(queued_blocks && ! hide)
+                    {
+                        int map_handle = item->regular_map ? item->regular_map->handle() : item->affine_map->handle();
+                        hide = bg_blocks_manager::queued(map_handle);
+                    }
+                #endif
+
+                if(hide != item->hidden)
+                {
+                    item->hidden = hide;
+                    display_manager::set_bg_enabled(item->handles_index, ! hide);
+                }
+
+                data.hidden_bgs |= hide;
+            }
+        }
+    }
+}
+
 void commit()
 {
     if(data.commit)
@@ -1399,6 +1559,9 @@ void commit()
 
 void commit_big_maps()
 {
+    int redraw_rows = data.big_maps_redraw_mode == big_map_redraw_mode::IMMEDIATE ?
+                22 : BN_CFG_BGS_BIG_MAPS_REDRAW_ROWS;
+
     for(item_type* item : data.items_vector)
     {
         if(item->big_map)
@@ -1406,29 +1569,9 @@ void commit_big_maps()
             bool is_regular = item->regular_map.has_value();
             int old_map_x = item->old_big_map_x;
             int old_map_y = item->old_big_map_y;
-            int new_map_x;
-            int new_map_y;
-
-            if(is_regular)
-            {
-                new_map_x = item->hw_position.x() >> 3;
-                new_map_y = item->hw_position.y() >> 3;
-            }
-            else
-            {
-                point affine_map_position = item->affine_map_position();
-                new_map_x = affine_map_position.x();
-                new_map_y = affine_map_position.y();
-
-                if(new_map_x % 2)
-                {
-                    --new_map_x;
-                }
-            }
-
-            new_map_x = min(new_map_x, (item->half_dimensions.width() / 4) - 32);
-            new_map_y = min(new_map_y, (item->half_dimensions.height() / 4) - 22);
-
+            point new_map_position = item->big_map_position();
+            int new_map_x = new_map_position.x();
+            int new_map_y = new_map_position.y();
             int map_handle = is_regular ? item->regular_map->handle() : item->affine_map->handle();
             bool full_commit_big_map = item->full_commit_big_map || bg_blocks_manager::must_commit(map_handle);
             bool commit_big_map = full_commit_big_map;
@@ -1445,8 +1588,19 @@ void commit_big_maps()
                 item->commit_big_map = false;
                 item->full_commit_big_map = false;
 
-                if(full_commit_big_map || bn::abs(new_map_x - old_map_x) > 8 || bn::abs(new_map_y - old_map_y) > 8)
+                bool jump = bn::abs(new_map_x - old_map_x) > 8 || bn::abs(new_map_y - old_map_y) > 8;
+
+                if(jump && ! full_commit_big_map && redraw_rows < 22)
                 {
+                    // The visible area is redrawn row by row in the next V-Blanks:
+                    item->redraw_begin_row = 0;
+                    item->redraw_end_row = 22;
+                }
+                else if(full_commit_big_map || jump)
+                {
+                    item->redraw_begin_row = 0;
+                    item->redraw_end_row = 0;
+
                     if(is_regular)
                     {
                         bg_blocks_manager::set_regular_map_position(map_handle, new_map_x, new_map_y);
@@ -1458,6 +1612,23 @@ void commit_big_maps()
                 }
                 else
                 {
+                    if(item->redraw_begin_row < item->redraw_end_row)
+                    {
+                        // Rows pending to be redrawn follow the visible area:
+                        int map_y_delta = new_map_y - old_map_y;
+                        int redraw_begin_row = max(item->redraw_begin_row - map_y_delta, 0);
+                        int redraw_end_row = min(item->redraw_end_row - map_y_delta, 22);
+
+                        if(redraw_begin_row >= redraw_end_row)
+                        {
+                            redraw_begin_row = 0;
+                            redraw_end_row = 0;
+                        }
+
+                        item->redraw_begin_row = int8_t(redraw_begin_row);
+                        item->redraw_end_row = int8_t(redraw_end_row);
+                    }
+
                     if(is_regular)
                     {
                         while(new_map_x < old_map_x)
@@ -1512,6 +1683,30 @@ void commit_big_maps()
                     }
                 }
             }
+
+            int redraw_begin_row = item->redraw_begin_row;
+            int redraw_end_row = item->redraw_end_row;
+
+            if(redraw_begin_row < redraw_end_row)
+            {
+                int redraw_limit_row = min(redraw_begin_row + redraw_rows, redraw_end_row);
+                int map_x = item->old_big_map_x;
+                int map_y = item->old_big_map_y;
+
+                for(int row = redraw_begin_row; row < redraw_limit_row; ++row)
+                {
+                    if(is_regular)
+                    {
+                        bg_blocks_manager::update_regular_map_row(map_handle, map_x, map_y + row);
+                    }
+                    else
+                    {
+                        bg_blocks_manager::update_affine_map_row(map_handle, map_x, map_y + row);
+                    }
+                }
+
+                item->redraw_begin_row = int8_t(redraw_limit_row);
+            }
         }
     }
 }
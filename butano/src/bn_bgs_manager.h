@@ -26,6 +26,7 @@ class regular_bg_attributes;
 class affine_mat_attributes;
 class affine_bg_mat_attributes;
 enum class bpp_mode;
+enum class big_map_redraw_mode;
 
 namespace bgs_manager
 {
@@ -35,6 +36,12 @@ namespace bgs_manager
 
     [[nodiscard]] int available_count();
 
+    [[nodiscard]] big_map_redraw_mode big_maps_redraw_mode();
+
+    void set_big_maps_redraw_mode(big_map_redraw_mode redraw_mode);
+
+    [[nodiscard]] int big_maps_redraw_pending_rows();
+
     [[nodiscard]] id_type create(regular_bg_builder&& builder);
 
     [[nodiscard]] id_type create(affine_bg_builder&& builder);
@@ -161,7 +168,7 @@ namespace bgs_manager
 
     void remove_camera(id_type id);
 
-    void update_cameras();
+    void update_camera(int camera_id);
 
     void update_regular_map_tiles_cbb(int map_id, int tiles_cbb);
 
@@ -169,6 +176,8 @@ namespace bgs_manager
 
     void update_regular_map_palette_bpp(int map_id, bpp_mode bpp);
 
+    void update_map_sbb(int old_map_id, int new_map_id);
+
     void reload();
 
     void fill_hblank_effect_regular_positions(int base_position, const fixed* positions_ptr, uint16_t* dest_ptr);
@@ -185,6 +194,8 @@ namespace bgs_manager
 
     void update();
 
+    void prepare_commit();
+
     void commit();
 
     void commit_big_maps();
@@ -30,6 +30,7 @@ namespace
     public:
         fixed_point position;
         unsigned usages = 0;
+        bool update = false;
     };
 
 
@@ -73,6 +74,7 @@ int create(const fixed_point& position)
     item_type& new_item = data.items[item_index];
     new_item.position = position;
     new_item.usages = 1;
+    new_item.update = false;
     return item_index;
 }
 
@@ -89,6 +91,7 @@ int create_optional(const fixed_point& position)
     item_type& new_item = data.items[item_index];
     new_item.position = position;
     new_item.usages = 1;
+    new_item.update = false;
     return item_index;
 }
 
@@ -122,6 +125,7 @@ void set_x(int id, fixed x)
     if(item.position.x() != x)
     {
         item.position.set_x(x);
+        item.update = true;
         data.update = true;
     }
 }
@@ -133,6 +137,7 @@ void set_y(int id, fixed y)
     if(item.position.y() != y)
     {
         item.position.set_y(y);
+        item.update = true;
         data.update = true;
     }
 }
@@ -144,6 +149,7 @@ void set_position(int id, const fixed_point& position)
     if(item.position != position)
     {
         item.position = position;
+        item.update = true;
         data.update = true;
     }
 }
@@ -154,9 +160,23 @@ void update()
     {
         data.update = false;
 
-        display_manager::update_cameras();
-        sprites_manager::update_cameras();
-        bgs_manager::update_cameras();
+        // Only the sprites and BGs attached to moved cameras are updated:
+        for(int index = 0; index < max_items; ++index)
+        {
+            item_type& item = data.items[index];
+
+            if(item.update)
+            {
+                item.update = false;
+
+                if(item.usages)
+                {
+                    display_manager::update_camera(index);
+                    sprites_manager::update_camera(index);
+                    bgs_manager::update_camera(index);
+                }
+            }
+        }
     }
 }
 
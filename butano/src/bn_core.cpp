@@ -203,6 +203,16 @@ void update()
     hdma_manager::update();
     BN_PROFILER_ENGINE_STOP();
 
+    BN_PROFILER_ENGINE_START("eng_vram_commit_prep");
+    sprite_tiles_manager::prepare_commit();
+    bg_blocks_manager::prepare_commit();
+    bgs_manager::prepare_commit();
+    BN_PROFILER_ENGINE_STOP();
+
+    BN_PROFILER_ENGINE_START("eng_sprites_commit_prep");
+    sprites_manager::prepare_commit();
+    BN_PROFILER_ENGINE_STOP();
+
     BN_PROFILER_ENGINE_START("eng_cpu_usage");
     data.last_cpu_usage_ticks = data.cpu_usage_timer.elapsed_ticks();
     BN_PROFILER_ENGINE_STOP();
@@ -214,6 +224,11 @@ void update()
     data.cpu_usage_timer.restart();
     BN_PROFILER_ENGINE_STOP();
 
+    // Sprites are committed first, so OAM writes finish before other V-Blank work:
+    BN_PROFILER_ENGINE_START("eng_sprites_commit");
+    sprites_manager::commit();
+    BN_PROFILER_ENGINE_STOP();
+
     BN_PROFILER_ENGINE_START("eng_hblank_fx_commit");
     hblank_effects_manager::commit();
     BN_PROFILER_ENGINE_STOP();
@@ -222,10 +237,6 @@ void update()
     display_manager::commit();
     BN_PROFILER_ENGINE_STOP();
 
-    BN_PROFILER_ENGINE_START("eng_sprites_commit");
-    sprites_manager::commit();
-    BN_PROFILER_ENGINE_STOP();
-
     BN_PROFILER_ENGINE_START("eng_bgs_commit");
     bgs_manager::commit();
     BN_PROFILER_ENGINE_STOP();
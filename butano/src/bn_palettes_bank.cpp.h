@@ -412,6 +412,7 @@ void palettes_bank::set_brightness(fixed brightness)
     {
         _update = true;
         _update_global_effects = true;
+        _update_channels_lut();
 
         if(output_brightness.data())
         {
@@ -436,6 +437,7 @@ void palettes_bank::set_contrast(fixed contrast)
     {
         _update = true;
         _update_global_effects = true;
+        _update_channels_lut();
 
         if(output_contrast.data())
         {
@@ -460,6 +462,7 @@ void palettes_bank::set_intensity(fixed intensity)
     {
         _update = true;
         _update_global_effects = true;
+        _update_channels_lut();
 
         if(output_intensity.data())
         {
@@ -481,6 +484,7 @@ void palettes_bank::set_inverted(bool inverted)
     {
         _update = true;
         _update_global_effects = true;
+        _update_channels_lut();
 
         if(inverted)
         {
@@ -744,6 +748,19 @@ void palettes_bank::_check_global_effects_enabled()
             fixed_t<5>(_fade_intensity).data();
 }
 
+void palettes_bank::_update_channels_lut()
+{
+    int brightness = fixed_t<8>(_brightness).data();
+    int contrast = fixed_t<8>(_contrast).data();
+    int intensity = fixed_t<8>(_intensity).data();
+    _channels_lut_enabled = brightness || contrast || intensity;
+
+    if(_channels_lut_enabled)
+    {
+        hw::palettes::fill_channels_lut(brightness, contrast, intensity, _inverted, _channels_lut);
+    }
+}
+
 void palettes_bank::_set_colors_bpp_impl(int id, const span<const color>& colors)
 {
     palette& pal = _palettes[id];
@@ -769,22 +786,12 @@ void palettes_bank::_update_palette(int id)
 
 void palettes_bank::_apply_global_effects(int dest_colors_count, color* dest_colors_ptr) const
 {
-    if(int brightness = fixed_t<8>(_brightness).data())
+    if(_channels_lut_enabled)
     {
-        hw::palettes::brightness(brightness, dest_colors_count, dest_colors_ptr);
+        // Brightness, contrast, intensity and inversion are applied at once:
+        hw::palettes::apply_channels_lut(_channels_lut, dest_colors_count, dest_colors_ptr);
     }
-
-    if(int contrast = fixed_t<8>(_contrast).data())
-    {
-        hw::palettes::contrast(contrast, dest_colors_count, dest_colors_ptr);
-    }
-
-    if(int intensity = fixed_t<8>(_intensity).data())
-    {
-        hw::palettes::intensity(intensity, dest_colors_count, dest_colors_ptr);
-    }
-
-    if(_inverted)
+    else if(_inverted)
     {
         hw::palettes::invert(dest_colors_count, dest_colors_ptr);
     }
@@ -208,6 +208,7 @@ private:
     palette _palettes[hw::palettes::count()] = {};
     alignas(int) color _initial_colors[hw::palettes::colors()] = {};
     alignas(int) color _final_colors[hw::palettes::colors()] = {};
+    uint8_t _channels_lut[32] = {};
     optional<color> _transparent_color;
     fixed _brightness;
     fixed _contrast;
@@ -222,6 +223,7 @@ private:
     bool _update = false;
     bool _update_global_effects = false;
     bool _global_effects_enabled = false;
+    bool _channels_lut_enabled = false;
 
     [[nodiscard]] bool _same_colors(const span<const color>& colors, int id) const;
 
@@ -231,6 +233,8 @@ private:
 
     void _check_global_effects_enabled();
 
+    void _update_channels_lut();
+
     void _set_colors_bpp_impl(int id, const span<const color>& colors);
 
     void _update_palette(int id);
@@ -8,6 +8,7 @@
 #include "bn_fixed.h"
 #include "bn_optional.h"
 #include "bn_regular_bg_ptr.h"
+#include "bn_regular_bg_builder.h"
 #include "bn_regular_bg_map_ptr.h"
 
 namespace bn
@@ -33,6 +34,20 @@ optional<regular_bg_ptr> regular_bg_item::create_bg_optional(const fixed_point&
     return regular_bg_ptr::create_optional(position, *this);
 }
 
+regular_bg_ptr regular_bg_item::create_bg_with_tiles_cache(fixed x, fixed y, int cache_tiles_count) const
+{
+    regular_bg_builder builder(regular_bg_map_ptr::create_new_with_tiles_cache(*this, cache_tiles_count));
+    builder.set_position(x, y);
+    return builder.release_build();
+}
+
+regular_bg_ptr regular_bg_item::create_bg_with_tiles_cache(const fixed_point& position, int cache_tiles_count) const
+{
+    regular_bg_builder builder(regular_bg_map_ptr::create_new_with_tiles_cache(*this, cache_tiles_count));
+    builder.set_position(position);
+    return builder.release_build();
+}
+
 optional<regular_bg_map_ptr> regular_bg_item::find_map() const
 {
     return regular_bg_map_ptr::find(*this);
@@ -72,6 +72,17 @@ regular_bg_map_ptr regular_bg_map_ptr::create_new(const regular_bg_item& item)
     return regular_bg_map_ptr(handle);
 }
 
+regular_bg_map_ptr regular_bg_map_ptr::create_new_with_tiles_cache(
+        const regular_bg_item& item, int cache_tiles_count)
+{
+    const regular_bg_tiles_item& tiles_item = item.tiles_item();
+    int handle = bg_blocks_manager::create_new_regular_map_with_tiles_cache(
+                item.map_item(), tiles_item.tiles_ref(),
+                regular_bg_tiles_ptr::allocate(cache_tiles_count, tiles_item.bpp()),
+                item.palette_item().create_palette());
+    return regular_bg_map_ptr(handle);
+}
+
 regular_bg_map_ptr regular_bg_map_ptr::allocate(
         const size& dimensions, regular_bg_tiles_ptr tiles, bg_palette_ptr palette)
 {
@@ -223,6 +234,11 @@ void regular_bg_map_ptr::reload_cells_ref()
     bg_blocks_manager::reload(_handle);
 }
 
+void regular_bg_map_ptr::reload_cells_ref(int x, int y, int width, int height)
+{
+    bg_blocks_manager::reload_regular_map_region(_handle, x, y, width, height);
+}
+
 const regular_bg_tiles_ptr& regular_bg_map_ptr::tiles() const
 {
     return bg_blocks_manager::regular_map_tiles(_handle);
@@ -64,6 +64,11 @@ public:
         _fields.z_order = uint16_t(z_order + numeric_limits<int16_t>::max());
     }
 
+    [[nodiscard]] constexpr unsigned data() const
+    {
+        return _data;
+    }
+
     [[nodiscard]] constexpr friend bool operator==(sort_key a, sort_key b)
     {
         return a._data == b._data;
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2020 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_sorted_sprites.h"
+
+#if BN_CFG_SPRITES_BATCHED_SORT_ENABLED
+
+#include "bn_memory.h"
+
+namespace bn::sorted_sprites
+{
+
+void sorter::_sort_impl()
+{
+    int items_count = _layer._items_count;
+    sprites_manager_item** items = _layer._items;
+    unsigned* keys = _keys;
+    unsigned last_key = 0;
+    bool sorted = true;
+
+    for(int index = 0; index < items_count; ++index)
+    {
+        unsigned key = items[index]->sprite_sort_key.data();
+        keys[index] = key;
+
+        if(key < last_key)
+        {
+            sorted = false;
+        }
+
+        last_key = key;
+    }
+
+    if(sorted)
+    {
+        return;
+    }
+
+    sprites_manager_item** temp_items = _temp_items;
+    unsigned* temp_keys = _temp_keys;
+    uint16_t* counts = _counts;
+
+    for(int shift = 0; shift < 32; shift += 8)
+    {
+        memory::clear(256, counts[0]);
+
+        for(int index = 0; index < items_count; ++index)
+        {
+            ++counts[(keys[index] >> shift) & 0xFF];
+        }
+
+        // Skip this digit if all keys share it:
+        if(counts[(keys[0] >> shift) & 0xFF] == items_count)
+        {
+            continue;
+        }
+
+        int offset = 0;
+
+        for(int digit = 0; digit < 256; ++digit)
+        {
+            int count = counts[digit];
+            counts[digit] = uint16_t(offset);
+            offset += count;
+        }
+
+        for(int index = 0; index < items_count; ++index)
+        {
+            unsigned key = keys[index];
+            int destination = counts[(key >> shift) & 0xFF]++;
+            temp_keys[destination] = key;
+            temp_items[destination] = items[index];
+        }
+
+        swap(items, temp_items);
+        swap(keys, temp_keys);
+    }
+
+    if(items != _layer._items)
+    {
+        memory::copy(*items, items_count, *_layer._items);
+    }
+}
+
+}
+
+#endif
@@ -7,115 +7,305 @@
 #define BN_SORTED_SPRITES_H
 
 #include "bn_pool.h"
+#include "bn_span.h"
 #include "bn_config_sprites.h"
 #include "bn_sprites_manager_item.h"
 
 namespace bn::sorted_sprites
 {
-    class layer : public intrusive_list_node_type
-    {
-
-    public:
-        explicit layer(sort_key sort_key) :
-            _sort_key(sort_key)
+    #if BN_CFG_SPRITES_BATCHED_SORT_ENABLED
+        class layer
         {
-        }
 
-        [[nodiscard]] sort_key layer_sort_key() const
-        {
-            return _sort_key;
-        }
+        public:
+            template<typename Item>
+            class items_range
+            {
 
-        [[nodiscard]] const intrusive_list<sprites_manager_item>& items() const
-        {
-            return _items;
-        }
+            public:
+                class iterator
+                {
 
-        [[nodiscard]] intrusive_list<sprites_manager_item>& items()
-        {
-            return _items;
-        }
+                public:
+                    explicit iterator(sprites_manager_item* const* item_ptr) :
+                        _item_ptr(item_ptr)
+                    {
+                    }
 
-    private:
-        sort_key _sort_key;
-        intrusive_list<sprites_manager_item> _items;
-    };
+                    [[nodiscard]] Item& operator*() const
+                    {
+                        return **_item_ptr;
+                    }
 
+                    iterator& operator++()
+                    {
+                        ++_item_ptr;
+                        return *this;
+                    }
 
-    using layers_type = intrusive_list<layer>;
+                    [[nodiscard]] friend bool operator!=(const iterator& a, const iterator& b)
+                    {
+                        return a._item_ptr != b._item_ptr;
+                    }
 
+                private:
+                    sprites_manager_item* const* _item_ptr;
+                };
 
-    class sorter
-    {
+                items_range(sprites_manager_item* const* items, int items_count) :
+                    _items(items),
+                    _items_count(items_count)
+                {
+                }
 
-    public:
-        [[nodiscard]] layers_type& layers()
-        {
-            return _layer_ptrs;
-        }
+                [[nodiscard]] iterator begin() const
+                {
+                    return iterator(_items);
+                }
+
+                [[nodiscard]] iterator end() const
+                {
+                    return iterator(_items + _items_count);
+                }
+
+            private:
+                sprites_manager_item* const* _items;
+                int _items_count;
+            };
+
+            [[nodiscard]] items_range<const sprites_manager_item> items() const
+            {
+                return items_range<const sprites_manager_item>(_items, _items_count);
+            }
+
+            [[nodiscard]] items_range<sprites_manager_item> items()
+            {
+                return items_range<sprites_manager_item>(_items, _items_count);
+            }
 
-        void insert(sprites_manager_item& item)
+        private:
+            friend class sorter;
+
+            sprites_manager_item* _items[BN_CFG_SPRITES_MAX_ITEMS];
+            int _items_count = 0;
+        };
+
+
+        /*
+         * Sprites are stored in a flat array which is sorted with a stable LSD radix sort over their sort keys
+         * once per frame, only if it has been modified.
+         *
+         * Sprites with the same sort key keep their relative order, and new sprites are inserted in front of them.
+         */
+        class sorter
         {
-            layers_type& layers = _layer_ptrs;
-            sort_key item_sort_key = item.sprite_sort_key;
-            layers_type::iterator layers_end = layers.end();
-            layers_type::iterator layers_it = lower_bound(layers.begin(), layers_end, item_sort_key,
-                    [](const layer& layer, sort_key sort_key) {
-                        return layer.layer_sort_key() < sort_key;
-                    });
 
-            if(layers_it == layers_end)
+        public:
+            sorter() :
+                _layers(&_layer, 1)
             {
-                BN_ASSERT(! _layer_pool.full(), "No more sprite sort layers available");
+            }
 
-                layer& pool_layer = _layer_pool.create(item_sort_key);
-                layers_it = layers.insert(layers_end, pool_layer);
+            [[nodiscard]] layers_type& layers()
+            {
+                return _layers;
             }
-            else if(item_sort_key != layers_it->layer_sort_key())
+
+            void insert(sprites_manager_item& item)
             {
-                BN_ASSERT(! _layer_pool.full(), "No more sprite sort layers available");
+                sprites_manager_item** items = _layer._items;
+
+                for(int index = _layer._items_count; index > 0; --index)
+                {
+                    items[index] = items[index - 1];
+                }
 
-                layer& pool_layer = _layer_pool.create(item_sort_key);
-                layers_it = layers.insert(layers_it, pool_layer);
+                items[0] = &item;
+                ++_layer._items_count;
+                item.sort_layer_ptr = &_layer;
+                _sort = true;
             }
 
-            layer& layer = *layers_it;
-            layer.items().push_front(item);
-            item.sort_layer_ptr = &layer;
-        }
+            void erase(sprites_manager_item& item)
+            {
+                sprites_manager_item** items = _layer._items;
+                int items_count = _layer._items_count - 1;
+                int index = 0;
+
+                while(items[index] != &item)
+                {
+                    ++index;
+                }
 
-        void erase(sprites_manager_item& item)
+                for(; index < items_count; ++index)
+                {
+                    items[index] = items[index + 1];
+                }
+
+                _layer._items_count = items_count;
+            }
+
+            void change_sort_key(sprites_manager_item& item, sort_key new_sort_key)
+            {
+                item.sprite_sort_key = new_sort_key;
+                _sort = true;
+            }
+
+            [[nodiscard]] bool put_in_front_of_layer(sprites_manager_item& item)
+            {
+                sprites_manager_item** items = _layer._items;
+                int index = 0;
+
+                while(items[index] != &item)
+                {
+                    ++index;
+                }
+
+                if(! index)
+                {
+                    return false;
+                }
+
+                for(; index > 0; --index)
+                {
+                    items[index] = items[index - 1];
+                }
+
+                items[0] = &item;
+                _sort = true;
+                return true;
+            }
+
+            void sort()
+            {
+                if(_sort)
+                {
+                    _sort = false;
+                    _sort_impl();
+                }
+            }
+
+        private:
+            layer _layer;
+            layers_type _layers;
+            sprites_manager_item* _temp_items[BN_CFG_SPRITES_MAX_ITEMS];
+            unsigned _keys[BN_CFG_SPRITES_MAX_ITEMS];
+            unsigned _temp_keys[BN_CFG_SPRITES_MAX_ITEMS];
+            uint16_t _counts[256];
+            bool _sort = false;
+
+            BN_CODE_IWRAM void _sort_impl();
+        };
+    #else
+        class layer : public intrusive_list_node_type
         {
-            layer* layer = item.sort_layer_ptr;
-            intrusive_list<sprites_manager_item>& layer_items = layer->items();
-            layer_items.erase(item);
 
-            if(layer_items.empty())
+        public:
+            explicit layer(sort_key sort_key) :
+                _sort_key(sort_key)
             {
-                _layer_ptrs.erase(*layer);
-                _layer_pool.destroy(*layer);
             }
-        }
 
-        [[nodiscard]] static bool put_in_front_of_layer(sprites_manager_item& item)
+            [[nodiscard]] sort_key layer_sort_key() const
+            {
+                return _sort_key;
+            }
+
+            [[nodiscard]] const intrusive_list<sprites_manager_item>& items() const
+            {
+                return _items;
+            }
+
+            [[nodiscard]] intrusive_list<sprites_manager_item>& items()
+            {
+                return _items;
+            }
+
+        private:
+            sort_key _sort_key;
+            intrusive_list<sprites_manager_item> _items;
+        };
+
+
+        class sorter
         {
-            layer* layer = item.sort_layer_ptr;
-            intrusive_list<sprites_manager_item>& layer_items = layer->items();
-            bool sort = &layer_items.front() != &item;
 
-            if(sort)
+        public:
+            [[nodiscard]] layers_type& layers()
+            {
+                return _layer_ptrs;
+            }
+
+            void insert(sprites_manager_item& item)
+            {
+                layers_type& layers = _layer_ptrs;
+                sort_key item_sort_key = item.sprite_sort_key;
+                layers_type::iterator layers_end = layers.end();
+                layers_type::iterator layers_it = lower_bound(layers.begin(), layers_end, item_sort_key,
+                        [](const layer& layer, sort_key sort_key) {
+                            return layer.layer_sort_key() < sort_key;
+                        });
+
+                if(layers_it == layers_end)
+                {
+                    BN_ASSERT(! _layer_pool.full(), "No more sprite sort layers available");
+
+                    layer& pool_layer = _layer_pool.create(item_sort_key);
+                    layers_it = layers.insert(layers_end, pool_layer);
+                }
+                else if(item_sort_key != layers_it->layer_sort_key())
+                {
+                    BN_ASSERT(! _layer_pool.full(), "No more sprite sort layers available");
+
+                    layer& pool_layer = _layer_pool.create(item_sort_key);
+                    layers_it = layers.insert(layers_it, pool_layer);
+                }
+
+                layer& layer = *layers_it;
+                layer.items().push_front(item);
+                item.sort_layer_ptr = &layer;
+            }
+
+            void erase(sprites_manager_item& item)
             {
+                layer* layer = item.sort_layer_ptr;
+                intrusive_list<sprites_manager_item>& layer_items = layer->items();
                 layer_items.erase(item);
-                layer_items.push_front(item);
+
+                if(layer_items.empty())
+                {
+                    _layer_ptrs.erase(*layer);
+                    _layer_pool.destroy(*layer);
+                }
+            }
+
+            void change_sort_key(sprites_manager_item& item, sort_key new_sort_key)
+            {
+                erase(item);
+                item.sprite_sort_key = new_sort_key;
+                insert(item);
             }
 
-            return sort;
-        }
+            [[nodiscard]] static bool put_in_front_of_layer(sprites_manager_item& item)
+            {
+                layer* layer = item.sort_layer_ptr;
+                intrusive_list<sprites_manager_item>& layer_items = layer->items();
+                bool sort = &layer_items.front() != &item;
+
+                if(sort)
+                {
+                    layer_items.erase(item);
+                    layer_items.push_front(item);
+                }
+
+                return sort;
+            }
 
-    private:
-        pool<layer, BN_CFG_SPRITES_MAX_SORT_LAYERS> _layer_pool;
-        layers_type _layer_ptrs;
-    };
+        private:
+            pool<layer, BN_CFG_SPRITES_MAX_SORT_LAYERS> _layer_pool;
+            layers_type _layer_ptrs;
+        };
+    #endif
 }
 
 #endif
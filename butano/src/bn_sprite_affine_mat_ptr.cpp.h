@@ -48,6 +48,18 @@ optional<sprite_affine_mat_ptr> sprite_affine_mat_ptr::create_optional(const aff
     return result;
 }
 
+#if BN_CFG_SPRITES_AFFINE_MATS_INTERNING_ENABLED
+    sprite_affine_mat_ptr sprite_affine_mat_ptr::_create_interned(const affine_mat_attributes& attributes)
+    {
+        return sprite_affine_mat_ptr(sprite_affine_mats_manager::create_interned(attributes));
+    }
+
+    bool sprite_affine_mat_ptr::_interned() const
+    {
+        return sprite_affine_mats_manager::interned(_id);
+    }
+#endif
+
 sprite_affine_mat_ptr::sprite_affine_mat_ptr(const sprite_affine_mat_ptr& other) :
     sprite_affine_mat_ptr(other._id)
 {
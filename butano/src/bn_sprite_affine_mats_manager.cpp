@@ -95,6 +95,11 @@ namespace
         int last_index_to_commit = 0;
         int first_index_to_remove_if_not_needed = max_items;
         int last_index_to_remove_if_not_needed = 0;
+
+        #if BN_CFG_SPRITES_AFFINE_MATS_INTERNING_ENABLED
+            unsigned interned_hashes[max_items];
+            unsigned interned_bits = 0;
+        #endif
     };
 
     BN_DATA_EWRAM static_data data;
@@ -106,8 +111,30 @@ namespace
         data.last_index_to_commit = max(data.last_index_to_commit, index);
     }
 
+    void _remove_interned([[maybe_unused]] int index)
+    {
+        #if BN_CFG_SPRITES_AFFINE_MATS_INTERNING_ENABLED
+            data.interned_bits &= ~(1u << unsigned(index));
+        #endif
+    }
+
+    #if BN_CFG_SPRITES_AFFINE_MATS_INTERNING_ENABLED
+        static_assert(max_items <= 32);
+
+        [[nodiscard]] unsigned _interned_hash(const affine_mat_attributes& attributes, bool double_size)
+        {
+            auto first = unsigned(attributes.pa_register_value() & 0xFFFF) |
+                    (unsigned(attributes.pb_register_value()) << 16);
+            auto second = unsigned(attributes.pc_register_value() & 0xFFFF) |
+                    (unsigned(attributes.pd_register_value()) << 16);
+            return first ^ ((second << 7) | (second >> 25)) ^ unsigned(double_size);
+        }
+    #endif
+
     void _update(int index)
     {
+        _remove_interned(index);
+
         item_type& item = data.items[index];
         const affine_mat_attributes& attributes = item.attributes;
         bool new_double_size;
@@ -232,6 +259,42 @@ int create_optional(const affine_mat_attributes& attributes)
     return _create(attributes);
 }
 
+#if BN_CFG_SPRITES_AFFINE_MATS_INTERNING_ENABLED
+    int create_interned(const affine_mat_attributes& attributes)
+    {
+        registers attributes_registers(attributes);
+        bool double_size = ! attributes.flipped_identity() && attributes.double_size();
+        unsigned hash = _interned_hash(attributes, double_size);
+        int index = 0;
+
+        for(unsigned interned_bits = data.interned_bits; interned_bits; interned_bits >>= 1, ++index)
+        {
+            if((interned_bits & 1) && data.interned_hashes[index] == hash)
+            {
+                item_type& item = data.items[index];
+
+                if(item.double_size == double_size && registers(item.attributes) == attributes_registers)
+                {
+                    ++item.usages;
+                    return index;
+                }
+            }
+        }
+
+        BN_ASSERT(! data.free_item_indexes.empty(), "No more sprite affine mats available");
+
+        int result = _create(attributes);
+        data.interned_hashes[result] = hash;
+        data.interned_bits |= 1u << unsigned(result);
+        return result;
+    }
+
+    bool interned(int id)
+    {
+        return data.interned_bits & (1u << unsigned(id));
+    }
+#endif
+
 void increase_usages(int id)
 {
     item_type& item = data.items[id];
@@ -248,6 +311,7 @@ void decrease_usages(int id)
         BN_ASSERT(item.attached_nodes.empty(), "There's still attached nodes");
 
         item.remove_if_not_needed = false;
+        _remove_interned(id);
         data.free_item_indexes.push_back(int8_t(id));
     }
 }
@@ -379,6 +443,7 @@ void set_horizontal_flip(int id, bool horizontal_flip)
     {
         item.attributes.set_horizontal_flip(horizontal_flip);
         hw::sprite_affine_mats::setup(item.attributes, data.handles_ptr[id]);
+        _remove_interned(id);
         _update_indexes_to_commit(id);
     }
 }
@@ -396,6 +461,7 @@ void set_vertical_flip(int id, bool vertical_flip)
     {
         item.attributes.set_vertical_flip(vertical_flip);
         hw::sprite_affine_mats::setup(item.attributes, data.handles_ptr[id]);
+        _remove_interned(id);
         _update_indexes_to_commit(id);
     }
 }
@@ -9,6 +9,7 @@
 #include "bn_fixed_fwd.h"
 #include "bn_optional_fwd.h"
 #include "bn_intrusive_list.h"
+#include "bn_config_sprites.h"
 
 namespace bn
 {
@@ -42,6 +43,12 @@ namespace bn::sprite_affine_mats_manager
 
     [[nodiscard]] int create_optional(const affine_mat_attributes& attributes);
 
+    #if BN_CFG_SPRITES_AFFINE_MATS_INTERNING_ENABLED
+        [[nodiscard]] int create_interned(const affine_mat_attributes& attributes);
+
+        [[nodiscard]] bool interned(int id);
+    #endif
+
     void increase_usages(int id);
 
     void decrease_usages(int id);
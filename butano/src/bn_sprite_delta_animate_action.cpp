@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2020 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_sprite_delta_animate_action.h"
+
+#include "bn_limits.h"
+#include "bn_optional.h"
+#include "../hw/include/bn_hw_sprite_tiles.h"
+
+namespace bn
+{
+
+sprite_delta_animate_action::sprite_delta_animate_action(
+        const sprite_ptr& sprite, int wait_updates, const sprite_tiles_delta_item& delta_item, bool forever) :
+    _sprite(sprite),
+    _delta_item(delta_item),
+    _even_tiles(sprite_tiles_ptr::allocate(delta_item.tiles_count_per_graphic(), delta_item.bpp())),
+    _odd_tiles(sprite_tiles_ptr::allocate(delta_item.tiles_count_per_graphic(), delta_item.bpp())),
+    _wait_updates(uint16_t(wait_updates)),
+    _forever(forever)
+{
+    BN_ASSERT(wait_updates >= 0, "Invalid wait updates: ", wait_updates);
+    BN_ASSERT(wait_updates <= numeric_limits<decltype(_wait_updates)>::max(),
+               "Too much wait updates: ", wait_updates);
+}
+
+sprite_delta_animate_action::sprite_delta_animate_action(
+        sprite_ptr&& sprite, int wait_updates, const sprite_tiles_delta_item& delta_item, bool forever) :
+    _sprite(move(sprite)),
+    _delta_item(delta_item),
+    _even_tiles(sprite_tiles_ptr::allocate(delta_item.tiles_count_per_graphic(), delta_item.bpp())),
+    _odd_tiles(sprite_tiles_ptr::allocate(delta_item.tiles_count_per_graphic(), delta_item.bpp())),
+    _wait_updates(uint16_t(wait_updates)),
+    _forever(forever)
+{
+    BN_ASSERT(wait_updates >= 0, "Invalid wait updates: ", wait_updates);
+    BN_ASSERT(wait_updates <= numeric_limits<decltype(_wait_updates)>::max(),
+               "Too much wait updates: ", wait_updates);
+}
+
+void sprite_delta_animate_action::update()
+{
+    BN_ASSERT(! done(), "Action is done");
+
+    if(_current_wait_updates)
+    {
+        --_current_wait_updates;
+    }
+    else
+    {
+        int graphics_count = _delta_item.graphics_count();
+        int graphics_index = _current_graphics_index;
+        int delta_index = _looped && graphics_index < 2 ? graphics_count + graphics_index : graphics_index;
+        _current_wait_updates = _wait_updates;
+
+        // The tile set which is not displayed contains the frame displayed two frames before:
+        sprite_tiles_ptr& tiles = _odd_step ? _odd_tiles : _even_tiles;
+        _upload(delta_index, tiles);
+        _sprite.set_tiles(tiles);
+        _odd_step = ! _odd_step;
+        ++graphics_index;
+
+        if(_forever && graphics_index == graphics_count)
+        {
+            graphics_index = 0;
+            _looped = true;
+        }
+
+        _current_graphics_index = uint16_t(graphics_index);
+    }
+}
+
+void sprite_delta_animate_action::_upload(int delta_index, sprite_tiles_ptr& tiles)
+{
+    const tile* source_tiles_ptr = _delta_item.delta_tiles_ref(delta_index).data();
+    span<const uint8_t> tile_indexes = _delta_item.delta_tile_indexes_ref(delta_index);
+    const uint8_t* tile_indexes_ptr = tile_indexes.data();
+    tile* destination_tiles_ptr = tiles.vram()->data();
+
+    // Consecutive tiles are copied in one go:
+    for(int index = 0, limit = tile_indexes.size(); index < limit; )
+    {
+        int tile_index = tile_indexes_ptr[index];
+        int count = 1;
+
+        while(index + count < limit && tile_indexes_ptr[index + count] == tile_index + count)
+        {
+            ++count;
+        }
+
+        hw::sprite_tiles::copy_tiles(source_tiles_ptr + index, count, destination_tiles_ptr + tile_index);
+        index += count;
+    }
+}
+
+}
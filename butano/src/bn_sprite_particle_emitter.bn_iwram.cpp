@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2020 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_sprite_particle_emitter.h"
+
+#include "bn_display.h"
+#include "../hw/include/bn_hw_sprites.h"
+
+namespace bn
+{
+
+void isprite_particle_emitter::update()
+{
+    fixed* xs = _xs;
+    fixed* ys = _ys;
+    fixed* velocity_xs = _velocity_xs;
+    fixed* velocity_ys = _velocity_ys;
+    int16_t* lifetimes = _lifetimes;
+    uint8_t* frames = _frames;
+    fixed acceleration_x = _acceleration.x();
+    fixed acceleration_y = _acceleration.y();
+    bool advance_frames = false;
+    int size = _size;
+
+    if(_frame_wait_updates)
+    {
+        if(--_frame_counter == 0)
+        {
+            _frame_counter = _frame_wait_updates;
+            advance_frames = true;
+        }
+    }
+
+    int last_frame = _frames_count - 1;
+    int index = 0;
+
+    while(index < size)
+    {
+        int lifetime = lifetimes[index] - 1;
+
+        if(lifetime)
+        {
+            fixed velocity_x = velocity_xs[index] + acceleration_x;
+            fixed velocity_y = velocity_ys[index] + acceleration_y;
+            velocity_xs[index] = velocity_x;
+            velocity_ys[index] = velocity_y;
+            xs[index] += velocity_x;
+            ys[index] += velocity_y;
+            lifetimes[index] = int16_t(lifetime);
+
+            if(advance_frames && frames[index] < last_frame)
+            {
+                ++frames[index];
+            }
+
+            ++index;
+        }
+        else
+        {
+            // Dead particles are replaced by the last one:
+            --size;
+            xs[index] = xs[size];
+            ys[index] = ys[size];
+            velocity_xs[index] = velocity_xs[size];
+            velocity_ys[index] = velocity_ys[size];
+            lifetimes[index] = lifetimes[size];
+            frames[index] = frames[size];
+        }
+    }
+
+    _size = size;
+}
+
+int isprite_particle_emitter::_write_handles(int max_handles, bool fade_enabled, void* hw_handles) const
+{
+    auto handles = static_cast<hw::sprites::handle_type*>(hw_handles);
+    const fixed* xs = _xs;
+    const fixed* ys = _ys;
+    const uint8_t* frames = _frames;
+    int width = _shape_size.width();
+    int height = _shape_size.height();
+    int x_offset = (display::width() - width) / 2;
+    int y_offset = (display::height() - height) / 2;
+    int tiles_per_frame = _tiles.tiles_count() / _frames_count;
+    hw::sprites::handle_type base_handle;
+    hw::sprites::setup_regular(_shape_size, _tiles.id(), _palette.id(), _palette.bpp(), fade_enabled, base_handle);
+    hw::sprites::set_bg_priority(_bg_priority, base_handle);
+
+    unsigned max_x = unsigned(display::width() + width - 1);
+    unsigned max_y = unsigned(display::height() + height - 1);
+    int handles_count = 0;
+
+    for(int index = 0, limit = _size; index < limit && handles_count < max_handles; ++index)
+    {
+        int x = xs[index].right_shift_integer() + x_offset;
+        int y = ys[index].right_shift_integer() + y_offset;
+
+        // Particles outside of the screen are discarded with one unsigned comparison per axis:
+        if(unsigned(x + width - 1) < max_x && unsigned(y + height - 1) < max_y)
+        {
+            hw::sprites::handle_type& handle = handles[handles_count];
+            handle.attr0 = base_handle.attr0;
+            handle.attr1 = base_handle.attr1;
+            handle.attr2 = uint16_t(base_handle.attr2 + (frames[index] * tiles_per_frame));
+            hw::sprites::set_x(x, handle);
+            hw::sprites::set_y(y, handle);
+            ++handles_count;
+        }
+    }
+
+    return handles_count;
+}
+
+}
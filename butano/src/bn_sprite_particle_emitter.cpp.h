@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2020 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_sprite_particle_emitter.h"
+
+#include "bn_sprites.h"
+#include "bn_sprite_item.h"
+#include "bn_sprite_particles_manager.h"
+
+namespace bn
+{
+
+namespace
+{
+    [[nodiscard]] sprite_tiles_ptr create_particle_tiles(const sprite_item& item)
+    {
+        const sprite_tiles_item& tiles_item = item.tiles_item();
+        BN_ASSERT(tiles_item.compression() == compression_type::NONE, "Compressed tiles not supported");
+
+        return sprite_tiles_item(tiles_item.tiles_ref(), tiles_item.bpp()).create_tiles();
+    }
+}
+
+isprite_particle_emitter::~isprite_particle_emitter()
+{
+    sprite_particles_manager::remove(*this);
+}
+
+void isprite_particle_emitter::set_max_handles(int max_handles)
+{
+    BN_ASSERT(max_handles >= 0 && max_handles <= BN_CFG_SPRITES_MAX_PARTICLE_HANDLES,
+              "Invalid max handles: ", max_handles);
+
+    _max_handles = max_handles;
+}
+
+void isprite_particle_emitter::set_bg_priority(int bg_priority)
+{
+    BN_ASSERT(bg_priority >= 0 && bg_priority <= sprites::max_bg_priority(), "Invalid BG priority: ", bg_priority);
+
+    _bg_priority = int8_t(bg_priority);
+}
+
+void isprite_particle_emitter::set_frame_wait_updates(int frame_wait_updates)
+{
+    BN_ASSERT(frame_wait_updates >= 0, "Invalid frame wait updates: ", frame_wait_updates);
+
+    _frame_wait_updates = frame_wait_updates;
+    _frame_counter = frame_wait_updates;
+}
+
+bool isprite_particle_emitter::emit(const fixed_point& position, const fixed_point& velocity, int lifetime)
+{
+    BN_ASSERT(lifetime > 0 && lifetime <= 32767, "Invalid lifetime: ", lifetime);
+
+    int index = _size;
+
+    if(index == _max_size)
+    {
+        return false;
+    }
+
+    _xs[index] = position.x();
+    _ys[index] = position.y();
+    _velocity_xs[index] = velocity.x();
+    _velocity_ys[index] = velocity.y();
+    _lifetimes[index] = int16_t(lifetime);
+    _frames[index] = 0;
+    _size = index + 1;
+    return true;
+}
+
+isprite_particle_emitter::isprite_particle_emitter(
+        const sprite_item& item, int max_size, fixed* xs, fixed* ys, fixed* velocity_xs, fixed* velocity_ys,
+        int16_t* lifetimes, uint8_t* frames) :
+    isprite_particle_emitter(
+        item.shape_size(), create_particle_tiles(item), item.palette_item().create_palette(),
+        item.tiles_item().graphics_count(), max_size, xs, ys, velocity_xs, velocity_ys, lifetimes, frames)
+{
+}
+
+isprite_particle_emitter::isprite_particle_emitter(
+        const sprite_shape_size& shape_size, sprite_tiles_ptr&& tiles, sprite_palette_ptr&& palette,
+        int frames_count, int max_size, fixed* xs, fixed* ys, fixed* velocity_xs, fixed* velocity_ys,
+        int16_t* lifetimes, uint8_t* frames) :
+    _shape_size(shape_size),
+    _tiles(move(tiles)),
+    _palette(move(palette)),
+    _xs(xs),
+    _ys(ys),
+    _velocity_xs(velocity_xs),
+    _velocity_ys(velocity_ys),
+    _lifetimes(lifetimes),
+    _frames(frames),
+    _max_size(max_size),
+    _frames_count(frames_count)
+{
+    BN_ASSERT(frames_count > 0 && frames_count <= 256, "Invalid frames count: ", frames_count);
+    BN_ASSERT(_tiles.tiles_count() % frames_count == 0,
+              "Invalid frames count: ", frames_count, " - ", _tiles.tiles_count());
+
+    sprite_particles_manager::add(*this);
+}
+
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2020 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_sprite_particles_manager.h"
+
+#include "bn_display_manager.h"
+#include "bn_sprite_tiles_manager.h"
+#include "bn_config_sprite_tiles.h"
+#include "bn_sprite_particle_emitter.h"
+#include "../hw/include/bn_hw_sprites.h"
+
+#include "bn_sprite_particle_emitter.cpp.h"
+
+namespace bn::sprite_particles_manager
+{
+
+namespace
+{
+    class static_data
+    {
+
+    public:
+        intrusive_list<isprite_particle_emitter> emitters;
+    };
+
+    BN_DATA_EWRAM static_data data;
+}
+
+void add(isprite_particle_emitter& emitter)
+{
+    data.emitters.push_back(emitter);
+}
+
+void remove(isprite_particle_emitter& emitter)
+{
+    data.emitters.erase(emitter);
+}
+
+int write_handles(int max_handles, void* hw_handles)
+{
+    auto handles = static_cast<hw::sprites::handle_type*>(hw_handles);
+    bool fade_enabled = display_manager::blending_fade_enabled();
+    int handles_count = 0;
+
+    #if BN_CFG_SPRITE_TILES_MAX_COMMIT_BYTES
+        bool queued_tiles = sprite_tiles_manager::queued_bytes();
+    #endif
+
+    for(const isprite_particle_emitter& emitter : data.emitters)
+    {
+        if(handles_count == max_handles)
+        {
+            break;
+        }
+
+        if(emitter.visible())
+        {
+            #if BN_CFG_SPRITE_TILES_MAX_COMMIT_BYTES
+                // Particles with tiles queued for the next V-Blanks are hidden until they are uploaded:
+                if(queued_tiles && sprite_tiles_manager::queued_tile(emitter.tiles().id()))
+                {
+                    continue;
+                }
+            #endif
+
+            handles_count += emitter._write_handles(min(emitter.max_handles(), max_handles - handles_count),
+                                                    fade_enabled, handles + handles_count);
+        }
+    }
+
+    return handles_count;
+}
+
+}
@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2020 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SPRITE_PARTICLES_MANAGER_H
+#define BN_SPRITE_PARTICLES_MANAGER_H
+
+#include "bn_common.h"
+
+namespace bn
+{
+    class isprite_particle_emitter;
+}
+
+namespace bn::sprite_particles_manager
+{
+    void add(isprite_particle_emitter& emitter);
+
+    void remove(isprite_particle_emitter& emitter);
+
+    [[nodiscard]] int write_handles(int max_handles, void* hw_handles);
+}
+
+#endif
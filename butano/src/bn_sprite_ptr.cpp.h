@@ -420,6 +420,17 @@ fixed sprite_ptr::rotation_angle() const
 
 void sprite_ptr::set_rotation_angle(fixed rotation_angle)
 {
+    #if BN_CFG_SPRITES_AFFINE_MATS_INTERNING_ENABLED
+        affine_mat_attributes interned_attributes;
+
+        if(sprites_manager::interned_affine_mat_attributes(_handle, interned_attributes))
+        {
+            interned_attributes.set_rotation_angle(rotation_angle);
+            sprites_manager::set_interned_affine_mat(_handle, interned_attributes);
+            return;
+        }
+    #endif
+
     if(optional<sprite_affine_mat_ptr>& affine_mat = sprites_manager::affine_mat(_handle))
     {
         affine_mat->set_rotation_angle(rotation_angle);
@@ -447,6 +458,17 @@ fixed sprite_ptr::horizontal_scale() const
 
 void sprite_ptr::set_horizontal_scale(fixed horizontal_scale)
 {
+    #if BN_CFG_SPRITES_AFFINE_MATS_INTERNING_ENABLED
+        affine_mat_attributes interned_attributes;
+
+        if(sprites_manager::interned_affine_mat_attributes(_handle, interned_attributes))
+        {
+            interned_attributes.set_horizontal_scale(horizontal_scale);
+            sprites_manager::set_interned_affine_mat(_handle, interned_attributes);
+            return;
+        }
+    #endif
+
     if(optional<sprite_affine_mat_ptr>& affine_mat = sprites_manager::affine_mat(_handle))
     {
         affine_mat->set_horizontal_scale(horizontal_scale);
@@ -474,6 +496,17 @@ fixed sprite_ptr::vertical_scale() const
 
 void sprite_ptr::set_vertical_scale(fixed vertical_scale)
 {
+    #if BN_CFG_SPRITES_AFFINE_MATS_INTERNING_ENABLED
+        affine_mat_attributes interned_attributes;
+
+        if(sprites_manager::interned_affine_mat_attributes(_handle, interned_attributes))
+        {
+            interned_attributes.set_vertical_scale(vertical_scale);
+            sprites_manager::set_interned_affine_mat(_handle, interned_attributes);
+            return;
+        }
+    #endif
+
     if(optional<sprite_affine_mat_ptr>& affine_mat = sprites_manager::affine_mat(_handle))
     {
         affine_mat->set_vertical_scale(vertical_scale);
@@ -491,6 +524,17 @@ void sprite_ptr::set_vertical_scale(fixed vertical_scale)
 
 void sprite_ptr::set_scale(fixed scale)
 {
+    #if BN_CFG_SPRITES_AFFINE_MATS_INTERNING_ENABLED
+        affine_mat_attributes interned_attributes;
+
+        if(sprites_manager::interned_affine_mat_attributes(_handle, interned_attributes))
+        {
+            interned_attributes.set_scale(scale);
+            sprites_manager::set_interned_affine_mat(_handle, interned_attributes);
+            return;
+        }
+    #endif
+
     if(optional<sprite_affine_mat_ptr>& affine_mat = sprites_manager::affine_mat(_handle))
     {
         affine_mat->set_scale(scale);
@@ -508,6 +552,17 @@ void sprite_ptr::set_scale(fixed scale)
 
 void sprite_ptr::set_scale(fixed horizontal_scale, fixed vertical_scale)
 {
+    #if BN_CFG_SPRITES_AFFINE_MATS_INTERNING_ENABLED
+        affine_mat_attributes interned_attributes;
+
+        if(sprites_manager::interned_affine_mat_attributes(_handle, interned_attributes))
+        {
+            interned_attributes.set_scale(horizontal_scale, vertical_scale);
+            sprites_manager::set_interned_affine_mat(_handle, interned_attributes);
+            return;
+        }
+    #endif
+
     if(optional<sprite_affine_mat_ptr>& affine_mat = sprites_manager::affine_mat(_handle))
     {
         affine_mat->set_scale(horizontal_scale, vertical_scale);
@@ -9,6 +9,7 @@
 #include "bn_any.h"
 #include "bn_sprite_third_attributes.h"
 #include "bn_sprites_manager.h"
+#include "bn_sprite_tiles_manager.h"
 #include "../hw/include/bn_hw_sprites.h"
 
 namespace bn
@@ -36,7 +37,9 @@ public:
         sprite_shape_size new_value = sprites_manager::shape_size(handle);
         bool updated = last_value != new_value;
         last_value = new_value;
-        return updated;
+
+        // Relocated sprite tiles change their tiles ids, so they must be written again:
+        return updated || sprite_tiles_manager::relocated();
     }
 
     [[nodiscard]] static uint16_t* output_register(intptr_t target_id)
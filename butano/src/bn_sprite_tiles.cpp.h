@@ -20,6 +20,11 @@ int available_tiles_count()
     return sprite_tiles_manager::available_tiles_count();
 }
 
+int available_contiguous_tiles_count()
+{
+    return sprite_tiles_manager::available_contiguous_tiles_count();
+}
+
 int used_items_count()
 {
     return sprite_tiles_manager::used_items_count();
@@ -30,6 +35,21 @@ int available_items_count()
     return sprite_tiles_manager::available_items_count();
 }
 
+int queued_bytes()
+{
+    return sprite_tiles_manager::queued_bytes();
+}
+
+void compact()
+{
+    sprite_tiles_manager::compact();
+}
+
+bool compacting()
+{
+    return sprite_tiles_manager::compacting();
+}
+
 #if BN_CFG_LOG_ENABLED
     void log_status()
     {
@@ -7,6 +7,7 @@
 
 #include "bn_vector.h"
 #include "bn_unordered_map.h"
+#include "bn_compression_type.h"
 #include "bn_config_sprite_tiles.h"
 #include "../hw/include/bn_hw_sprite_tiles.h"
 #include "../hw/include/bn_hw_sprite_tiles_constants.h"
@@ -32,6 +33,10 @@ namespace
     static_assert(BN_CFG_SPRITE_TILES_MAX_ITEMS > 0 &&
                   BN_CFG_SPRITE_TILES_MAX_ITEMS <= hw::sprite_tiles::tiles_count());
     static_assert(power_of_two(BN_CFG_SPRITE_TILES_MAX_ITEMS));
+    static_assert(BN_CFG_SPRITE_TILES_MAX_COMMIT_BYTES >= 0);
+    static_assert(BN_CFG_SPRITE_TILES_COMPACTION_MAX_TILES > 0);
+    static_assert(BN_CFG_SPRITE_TILES_COMPACTION_THRESHOLD >= 0 &&
+                  BN_CFG_SPRITE_TILES_COMPACTION_THRESHOLD <= hw::sprite_tiles::tiles_count());
 
 
     constexpr const int max_items = BN_CFG_SPRITE_TILES_MAX_ITEMS;
@@ -61,14 +66,21 @@ namespace
     public:
         const tile* data = nullptr;
         unsigned usages = 0;
+        uint16_t data_tiles_count = 0;
+        uint16_t sized_prev_index = max_list_items;
+        uint16_t sized_next_index = max_list_items;
         unsigned start_tile: 12 = 0;
         unsigned tiles_count: 12 = 0;
 
     private:
         unsigned _status: 2 = unsigned(status_type::FREE);
+        unsigned _compression: 2 = unsigned(compression_type::NONE);
 
     public:
         bool commit: 1 = false;
+        bool resident: 1 = false;
+        bool queued: 1 = false;
+        bool relocated: 1 = false;
 
         [[nodiscard]] status_type status() const
         {
@@ -79,6 +91,16 @@ namespace
         {
             _status = unsigned(status);
         }
+
+        [[nodiscard]] compression_type compression() const
+        {
+            return static_cast<compression_type>(_compression);
+        }
+
+        void set_compression(compression_type compression)
+        {
+            _compression = unsigned(compression);
+        }
     };
 
 
@@ -248,18 +270,247 @@ namespace
     };
 
 
+    [[nodiscard]] constexpr int _size_class(int tiles_count)
+    {
+        int result = 0;
+
+        for(tiles_count >>= 1; tiles_count; tiles_count >>= 1)
+        {
+            ++result;
+        }
+
+        return result;
+    }
+
+
+    /*
+     * Segregated lists of items indexed by size class (floor(log2(tiles_count))).
+     *
+     * Each list is a doubly linked list through the item sized_prev_index and sized_next_index fields,
+     * and the non empty lists are indexed by a bitmap, so insertions and removals are O(1)
+     * and the lookup of the first list with enough tiles only checks one bit per size class.
+     *
+     * Lookups return the smallest item with enough tiles (best fit), like the sorted vectors used before.
+     */
+    class sized_items_lists
+    {
+
+    public:
+        constexpr static int classes_count = _size_class(hw::sprite_tiles::tiles_count()) + 1;
+
+        static_assert(classes_count <= 32);
+
+        void init()
+        {
+            for(uint16_t& head : _heads)
+            {
+                head = max_list_items;
+            }
+
+            _bits = 0;
+            _size = 0;
+        }
+
+        [[nodiscard]] int size() const
+        {
+            return _size;
+        }
+
+        [[nodiscard]] bool empty() const
+        {
+            return ! _size;
+        }
+
+        [[nodiscard]] int front() const
+        {
+            unsigned bits = _bits;
+
+            for(int size_class = 0; bits; bits >>= 1, ++size_class)
+            {
+                if(bits & 1)
+                {
+                    return _heads[size_class];
+                }
+            }
+
+            return -1;
+        }
+
+        void push(int id, items_list& items)
+        {
+            item_type& item = items.item(id);
+            int size_class = _size_class(item.tiles_count);
+            int head = _heads[size_class];
+            item.sized_prev_index = max_list_items;
+            item.sized_next_index = uint16_t(head);
+
+            if(head != max_list_items)
+            {
+                items.item(head).sized_prev_index = uint16_t(id);
+            }
+
+            _heads[size_class] = uint16_t(id);
+            _bits |= 1u << unsigned(size_class);
+            ++_size;
+        }
+
+        void erase(int id, items_list& items)
+        {
+            item_type& item = items.item(id);
+            int prev_index = item.sized_prev_index;
+            int next_index = item.sized_next_index;
+
+            if(prev_index != max_list_items)
+            {
+                items.item(prev_index).sized_next_index = uint16_t(next_index);
+            }
+            else
+            {
+                int size_class = _size_class(item.tiles_count);
+                BN_ASSERT(_heads[size_class] == id, "Item not found: ", id);
+
+                _heads[size_class] = uint16_t(next_index);
+
+                if(next_index == max_list_items)
+                {
+                    _bits &= ~(1u << unsigned(size_class));
+                }
+            }
+
+            if(next_index != max_list_items)
+            {
+                items.item(next_index).sized_prev_index = uint16_t(prev_index);
+            }
+
+            item.sized_prev_index = max_list_items;
+            item.sized_next_index = max_list_items;
+            --_size;
+        }
+
+        [[nodiscard]] int find_exact(int tiles_count, items_list& items) const
+        {
+            int size_class = _size_class(tiles_count);
+            int result = -1;
+
+            // Items are pushed to the front, so the last one found is the oldest:
+            for(int id = _heads[size_class]; id != max_list_items; id = items.item(id).sized_next_index)
+            {
+                if(int(items.item(id).tiles_count) == tiles_count)
+                {
+                    result = id;
+                }
+            }
+
+            return result;
+        }
+
+        [[nodiscard]] int find_fit(int tiles_count, items_list& items) const
+        {
+            // Items of the same size class can be smaller if tiles_count is not a power of two:
+            int size_class = _size_class(tiles_count);
+            int result = _find_smallest(size_class, tiles_count, items);
+
+            if(result == -1)
+            {
+                // All items of the greater size classes are big enough,
+                // so the smallest one is in the first non-empty class:
+                unsigned bits = _bits >> unsigned(size_class + 1);
+
+                for(++size_class; bits; bits >>= 1, ++size_class)
+                {
+                    if(bits & 1)
+                    {
+                        result = _find_smallest(size_class, tiles_count, items);
+                        break;
+                    }
+                }
+            }
+
+            return result;
+        }
+
+        [[nodiscard]] int max_tiles_count(items_list& items) const
+        {
+            unsigned bits = _bits;
+            int size_class = -1;
+
+            for(; bits; bits >>= 1)
+            {
+                ++size_class;
+            }
+
+            int result = 0;
+
+            if(size_class >= 0)
+            {
+                for(int id = _heads[size_class]; id != max_list_items; id = items.item(id).sized_next_index)
+                {
+                    result = max(result, int(items.item(id).tiles_count));
+                }
+            }
+
+            return result;
+        }
+
+        template<typename Function>
+        void for_each(items_list& items, const Function& function) const
+        {
+            for(uint16_t head : _heads)
+            {
+                for(int id = head; id != max_list_items; id = items.item(id).sized_next_index)
+                {
+                    function(id);
+                }
+            }
+        }
+
+    private:
+        uint16_t _heads[classes_count];
+        unsigned _bits = 0;
+        int _size = 0;
+
+        [[nodiscard]] int _find_smallest(int size_class, int tiles_count, items_list& items) const
+        {
+            int result = -1;
+            int result_tiles_count = 0;
+
+            // Items are pushed to the front, so the oldest one of the smallest items is returned:
+            for(int id = _heads[size_class]; id != max_list_items; id = items.item(id).sized_next_index)
+            {
+                int item_tiles_count = items.item(id).tiles_count;
+
+                if(item_tiles_count >= tiles_count && (result == -1 || item_tiles_count <= result_tiles_count))
+                {
+                    result = id;
+                    result_tiles_count = item_tiles_count;
+                }
+            }
+
+            return result;
+        }
+    };
+
+
     class static_data
     {
 
     public:
         items_list items;
         unordered_map<const tile*, int, max_items * 2> items_map;
-        vector<uint16_t, max_items> free_items;
-        vector<uint16_t, max_items> to_remove_items;
+        sized_items_lists free_items;
+        sized_items_lists to_remove_items;
         int free_tiles_count = 0;
         int to_remove_tiles_count = 0;
         bool check_commit = false;
         bool delay_commit = false;
+        bool check_compaction = false;
+        bool compacting = false;
+        bool relocated = false;
+
+        #if BN_CFG_SPRITE_TILES_MAX_COMMIT_BYTES
+            vector<uint16_t, max_items> queued_new_items;
+            int queued_bytes = 0;
+        #endif
     };
 
     BN_DATA_EWRAM static_data data;
@@ -297,10 +548,7 @@ namespace
 
             BN_LOG(']');
 
-            BN_LOG("free_items: ", data.free_items.size());
-            BN_LOG('[');
-
-            for(int item_index : data.free_items)
+            auto log_item = [](int item_index)
             {
                 const item_type& item = data.items.item(item_index);
                 BN_LOG("    ",
@@ -308,29 +556,23 @@ namespace
                         " - data: ", item.data,
                         " - start_tile: ", item.start_tile,
                         " - tiles_count: ", item.tiles_count);
-            }
+            };
 
+            BN_LOG("free_items: ", data.free_items.size());
+            BN_LOG('[');
+            data.free_items.for_each(data.items, log_item);
             BN_LOG(']');
 
             BN_LOG("to_remove_items: ", data.to_remove_items.size());
             BN_LOG('[');
-
-            for(int item_index : data.to_remove_items)
-            {
-                const item_type& item = data.items.item(item_index);
-                BN_LOG("    ",
-                        "index: ", item_index,
-                        " - data: ", item.data,
-                        " - start_tile: ", item.start_tile,
-                        " - tiles_count: ", item.tiles_count);
-            }
-
+            data.to_remove_items.for_each(data.items, log_item);
             BN_LOG(']');
 
             BN_LOG("free_tiles_count: ", data.free_tiles_count);
             BN_LOG("to_remove_tiles_count: ", data.to_remove_tiles_count);
             BN_LOG("check_commit: ", (data.check_commit ? "true" : "false"));
             BN_LOG("delay_commit: ", (data.delay_commit ? "true" : "false"));
+            BN_LOG("compacting: ", (data.compacting ? "true" : "false"));
         }
 
         #define BN_SPRITE_TILES_LOG BN_LOG
@@ -350,70 +592,41 @@ namespace
     #endif
 
 
-    constexpr const auto lower_bound_comparator = [](int item_index, unsigned tiles_count)
-    {
-        return data.items.item(item_index).tiles_count < tiles_count;
-    };
-
-    constexpr const auto upper_bound_comparator = [](unsigned tiles_count, int item_index)
-    {
-        return tiles_count < data.items.item(item_index).tiles_count;
-    };
-
-    void _insert_free_item(int id, ivector<uint16_t>::iterator free_items_last)
-    {
-        const item_type& item = data.items.item(id);
-        auto free_items_it = upper_bound(data.free_items.begin(), free_items_last, item.tiles_count,
-                                         upper_bound_comparator);
-        data.free_items.insert(free_items_it, id);
-    }
-
     void _insert_free_item(int id)
     {
-        _insert_free_item(id, data.free_items.end());
+        data.free_items.push(id, data.items);
     }
 
     void _erase_free_item(int id)
     {
-        const item_type& item = data.items.item(id);
-        auto free_items_end = data.free_items.end();
-        auto free_items_it = lower_bound(data.free_items.begin(), free_items_end, item.tiles_count,
-                                         lower_bound_comparator);
-        BN_ASSERT(free_items_it != free_items_end, "Free item not found: ", id);
-
-        while(*free_items_it != id)
-        {
-            ++free_items_it;
-        }
-
-        data.free_items.erase(free_items_it);
+        data.free_items.erase(id, data.items);
     }
 
     void _insert_to_remove_item(int id)
     {
-        const item_type& item = data.items.item(id);
-        auto to_remove_items_it = upper_bound(data.to_remove_items.begin(), data.to_remove_items.end(),
-                                              item.tiles_count, upper_bound_comparator);
-        data.to_remove_items.insert(to_remove_items_it, id);
+        data.to_remove_items.push(id, data.items);
     }
 
     void _erase_to_remove_item(int id)
     {
-        const item_type& item = data.items.item(id);
-        auto to_remove_items_end = data.to_remove_items.end();
-        auto to_remove_items_it = lower_bound(data.to_remove_items.begin(), to_remove_items_end, item.tiles_count,
-                                              lower_bound_comparator);
-        BN_ASSERT(to_remove_items_it != to_remove_items_end, "To remove item not found: ", id);
+        data.to_remove_items.erase(id, data.items);
+    }
 
-        while(*to_remove_items_it != id)
+    [[nodiscard]] int _tiles_count(const span<const tile>& tiles_ref, compression_type compression)
+    {
+        if(compression == compression_type::NONE)
         {
-            ++to_remove_items_it;
+            return tiles_ref.size();
         }
 
-        data.to_remove_items.erase(to_remove_items_it);
+        int tiles_count = hw::decompress::decompressed_size(tiles_ref.data()) / int(sizeof(tile));
+        BN_ASSERT(tiles_count > 0, "Invalid compressed tiles data: ", tiles_ref.data());
+
+        return tiles_count;
     }
 
-    [[nodiscard]] int _find_impl(const tile* tiles_data, [[maybe_unused]] int tiles_count)
+    [[nodiscard]] int _find_impl(const tile* tiles_data, [[maybe_unused]] compression_type compression,
+                                 [[maybe_unused]] int tiles_count)
     {
         auto items_map_iterator = data.items_map.find(tiles_data);
 
@@ -426,6 +639,8 @@ namespace
                       tiles_data, " - ", item.data);
             BN_ASSERT(tiles_count == item.tiles_count, "Tiles count does not match item tiles count: ",
                       tiles_count, " - ", item.tiles_count);
+            BN_ASSERT(compression == item.compression(), "Compression does not match item compression: ",
+                      int(compression), " - ", int(item.compression()));
 
             switch(item.status())
             {
@@ -461,9 +676,12 @@ namespace
         return -1;
     }
 
-    void _commit_item(const tile* tiles_data, bool delay_commit, item_type& item)
+    void _commit_item(const span<const tile>& tiles_ref, compression_type compression, bool delay_commit,
+                      item_type& item)
     {
-        item.data = tiles_data;
+        item.data = tiles_ref.data();
+        item.data_tiles_count = uint16_t(tiles_ref.size());
+        item.set_compression(compression);
 
         if(delay_commit)
         {
@@ -472,12 +690,15 @@ namespace
         }
         else
         {
-            hw::sprite_tiles::commit(tiles_data, item.start_tile, item.tiles_count);
+            hw::sprite_tiles::commit(item.data, compression, item.start_tile, item.tiles_count);
+            item.resident = true;
         }
     }
 
-    [[nodiscard]] optional<int> _create_item(int id, const tile* tiles_data, int tiles_count, bool delay_commit)
+    [[nodiscard]] optional<int> _create_item(int id, const span<const tile>& tiles_ref, compression_type compression,
+                                             int tiles_count, bool delay_commit)
     {
+        const tile* tiles_data = tiles_ref.data();
         item_type& item = data.items.item(id);
         int new_item_tiles_count = item.tiles_count - tiles_count;
 
@@ -503,14 +724,18 @@ namespace
         }
 
         item.data = tiles_data;
+        item.data_tiles_count = 0;
         item.tiles_count = uint16_t(tiles_count);
         item.usages = 1;
         item.commit = false;
+        item.resident = ! tiles_data;
+        item.queued = false;
         item.set_status(status_type::USED);
+        item.set_compression(compression_type::NONE);
 
         if(tiles_data)
         {
-            _commit_item(tiles_data, delay_commit, item);
+            _commit_item(tiles_ref, compression, delay_commit, item);
         }
 
         optional<int> new_free_item_id;
@@ -530,52 +755,41 @@ namespace
         return new_free_item_id;
     }
 
-    [[nodiscard]] int _create_impl(const tile* tiles_data, int tiles_count)
+    [[nodiscard]] int _create_impl(const span<const tile>& tiles_ref, compression_type compression, int tiles_count)
     {
         bool check_to_remove_tiles = tiles_count <= data.to_remove_tiles_count;
 
         if(check_to_remove_tiles)
         {
-            auto to_remove_items_end = data.to_remove_items.end();
-            auto to_remove_items_it = lower_bound(data.to_remove_items.begin(), to_remove_items_end, tiles_count,
-                                                  lower_bound_comparator);
+            int id = data.to_remove_items.find_exact(tiles_count, data.items);
 
-            if(to_remove_items_it != to_remove_items_end)
+            if(id >= 0)
             {
-                int id = *to_remove_items_it;
-                const item_type& item = data.items.item(id);
+                _erase_to_remove_item(id);
 
-                if(item.tiles_count == tiles_count)
+                if(optional<int> new_free_item_id = _create_item(id, tiles_ref, compression, tiles_count, true))
                 {
-                    data.to_remove_items.erase(to_remove_items_it);
-
-                    if(optional<int> new_free_item_id = _create_item(id, tiles_data, tiles_count, true))
-                    {
-                        _insert_free_item(*new_free_item_id);
-                    }
-
-                    return id;
+                    _insert_free_item(*new_free_item_id);
                 }
+
+                return id;
             }
         }
 
         if(tiles_count <= data.free_tiles_count)
         {
-            auto free_items_end = data.free_items.end();
-            auto free_items_it = lower_bound(data.free_items.begin(), free_items_end, tiles_count,
-                                             lower_bound_comparator);
+            int id = data.free_items.find_fit(tiles_count, data.items);
 
-            if(free_items_it != free_items_end)
+            if(id >= 0)
             {
-                int id = *free_items_it;
+                _erase_free_item(id);
 
-                if(optional<int> new_free_item_id = _create_item(id, tiles_data, tiles_count, data.delay_commit))
+                if(optional<int> new_free_item_id = _create_item(id, tiles_ref, compression, tiles_count,
+                                                                 data.delay_commit))
                 {
-                    _insert_free_item(*new_free_item_id, free_items_it);
-                    ++free_items_it;
+                    _insert_free_item(*new_free_item_id);
                 }
 
-                data.free_items.erase(free_items_it);
                 return id;
             }
         }
@@ -584,7 +798,7 @@ namespace
         {
             update();
             data.delay_commit = true;
-            return _create_impl(tiles_data, tiles_count);
+            return _create_impl(tiles_ref, compression, tiles_count);
         }
 
         return -1;
@@ -599,27 +813,100 @@ namespace
 
         if(tiles_count <= data.free_tiles_count)
         {
-            auto free_items_end = data.free_items.end();
-            auto free_items_it = lower_bound(data.free_items.begin(), free_items_end, tiles_count,
-                                             lower_bound_comparator);
+            int id = data.free_items.find_fit(tiles_count, data.items);
 
-            if(free_items_it != free_items_end)
+            if(id >= 0)
             {
-                int id = *free_items_it;
+                _erase_free_item(id);
 
-                if(optional<int> new_free_item_id = _create_item(id, nullptr, tiles_count, false))
+                if(optional<int> new_free_item_id = _create_item(id, span<const tile>(), compression_type::NONE,
+                                                                 tiles_count, false))
                 {
-                    _insert_free_item(*new_free_item_id, free_items_it);
-                    ++free_items_it;
+                    _insert_free_item(*new_free_item_id);
                 }
 
-                data.free_items.erase(free_items_it);
                 return id;
             }
         }
 
         return -1;
     }
+
+    [[nodiscard]] bool _relocatable(const item_type& item)
+    {
+        // Tiles are uploaded again from their source data, so allocated items and pending commits are skipped:
+        return item.status() == status_type::USED && item.data && ! item.commit;
+    }
+
+    [[nodiscard]] items_list::iterator _relocate(int free_id, int used_id)
+    {
+        item_type& free_item = data.items.item(free_id);
+        item_type& used_item = data.items.item(used_id);
+        int free_start_tile = free_item.start_tile;
+        int free_tiles_count = free_item.tiles_count;
+        _erase_free_item(free_id);
+        data.items.erase(free_id);
+
+        BN_SPRITE_TILES_LOG("RELOCATE: ", used_item.start_tile, " -> ", free_start_tile);
+
+        used_item.start_tile = unsigned(free_start_tile);
+        used_item.commit = true;
+        used_item.relocated = true;
+        data.check_commit = true;
+        data.relocated = true;
+
+        item_type new_free_item;
+        new_free_item.start_tile = unsigned(free_start_tile) + used_item.tiles_count;
+        new_free_item.tiles_count = unsigned(free_tiles_count);
+
+        auto next_iterator = data.items.it(used_id);
+        ++next_iterator;
+
+        if(next_iterator != data.items.end() && next_iterator->status() == status_type::FREE)
+        {
+            int next_id = next_iterator.id();
+            new_free_item.tiles_count += next_iterator->tiles_count;
+            _erase_free_item(next_id);
+            data.items.erase(next_id);
+        }
+
+        auto new_free_iterator = data.items.insert(used_item.next_index, new_free_item);
+        _insert_free_item(new_free_iterator.id());
+        return new_free_iterator;
+    }
+
+    [[nodiscard]] bool _compact()
+    {
+        // Free items are moved forward by swapping them with the next used items, so gaps are merged at the end:
+        int relocated_tiles_count = 0;
+
+        for(auto it = data.items.begin(), end = data.items.end(); it != end; ++it)
+        {
+            if(it->status() == status_type::FREE)
+            {
+                auto next_it = it;
+                ++next_it;
+
+                while(next_it != end && _relocatable(*next_it))
+                {
+                    int tiles_count = next_it->tiles_count;
+
+                    if(relocated_tiles_count &&
+                            relocated_tiles_count + tiles_count > BN_CFG_SPRITE_TILES_COMPACTION_MAX_TILES)
+                    {
+                        return true;
+                    }
+
+                    it = _relocate(it.id(), next_it.id());
+                    relocated_tiles_count += tiles_count;
+                    next_it = it;
+                    ++next_it;
+                }
+            }
+        }
+
+        return false;
+    }
 }
 
 void init()
@@ -630,7 +917,9 @@ void init()
     new_item.tiles_count = hw::sprite_tiles::tiles_count();
     data.items.init();
     data.items.push_front(new_item);
-    data.free_items.push_back(data.items.begin().id());
+    data.free_items.init();
+    data.to_remove_items.init();
+    _insert_free_item(data.items.begin().id());
     data.free_tiles_count = new_item.tiles_count;
 
     BN_SPRITE_TILES_LOG_STATUS();
@@ -646,6 +935,11 @@ int available_tiles_count()
     return data.free_tiles_count;
 }
 
+int available_contiguous_tiles_count()
+{
+    return data.free_items.max_tiles_count(data.items);
+}
+
 int used_items_count()
 {
     return data.items.size();
@@ -656,6 +950,27 @@ int available_items_count()
     return data.items.available();
 }
 
+int queued_bytes()
+{
+    #if BN_CFG_SPRITE_TILES_MAX_COMMIT_BYTES
+        return data.queued_bytes;
+    #else
+        return 0;
+    #endif
+}
+
+void compact()
+{
+    BN_SPRITE_TILES_LOG("sprite_tiles_manager - COMPACT");
+
+    data.compacting = true;
+}
+
+bool compacting()
+{
+    return data.compacting;
+}
+
 #if BN_CFG_LOG_ENABLED
     void log_status()
     {
@@ -684,31 +999,31 @@ int available_items_count()
     }
 #endif
 
-int find(const span<const tile>& tiles_ref)
+int find(const span<const tile>& tiles_ref, compression_type compression)
 {
     const tile* tiles_data = tiles_ref.data();
-    int tiles_count = tiles_ref.size();
+    int tiles_count = _tiles_count(tiles_ref, compression);
 
     BN_SPRITE_TILES_LOG("sprite_tiles_manager - FIND: ", tiles_data, " - ", tiles_count);
 
-    return _find_impl(tiles_data, tiles_count);
+    return _find_impl(tiles_data, compression, tiles_count);
 }
 
-int create(const span<const tile>& tiles_ref)
+int create(const span<const tile>& tiles_ref, compression_type compression)
 {
     const tile* tiles_data = tiles_ref.data();
-    int tiles_count = tiles_ref.size();
+    int tiles_count = _tiles_count(tiles_ref, compression);
 
     BN_SPRITE_TILES_LOG("sprite_tiles_manager - CREATE: ", tiles_data, " - ", tiles_count);
 
-    int result = _find_impl(tiles_data, tiles_count);
+    int result = _find_impl(tiles_data, compression, tiles_count);
 
     if(result != -1)
     {
         return result;
     }
 
-    result = _create_impl(tiles_data, tiles_count);
+    result = _create_impl(tiles_ref, compression, tiles_count);
 
     if(result != -1)
     {
@@ -736,17 +1051,17 @@ int create(const span<const tile>& tiles_ref)
     return result;
 }
 
-int create_new(const span<const tile>& tiles_ref)
+int create_new(const span<const tile>& tiles_ref, compression_type compression)
 {
     const tile* tiles_data = tiles_ref.data();
-    int tiles_count = tiles_ref.size();
+    int tiles_count = _tiles_count(tiles_ref, compression);
 
     BN_SPRITE_TILES_LOG("sprite_tiles_manager - CREATE NEW: ", tiles_data, " - ", tiles_count);
 
     BN_ASSERT(data.items_map.find(tiles_data) == data.items_map.end(),
               "Multiple copies of the same tiles data not supported");
 
-    int result = _create_impl(tiles_data, tiles_count);
+    int result = _create_impl(tiles_ref, compression, tiles_count);
 
     if(result != -1)
     {
@@ -805,21 +1120,21 @@ int allocate(int tiles_count, bpp_mode bpp)
     return result;
 }
 
-int create_optional(const span<const tile>& tiles_ref)
+int create_optional(const span<const tile>& tiles_ref, compression_type compression)
 {
     const tile* tiles_data = tiles_ref.data();
-    int tiles_count = tiles_ref.size();
+    int tiles_count = _tiles_count(tiles_ref, compression);
 
     BN_SPRITE_TILES_LOG("sprite_tiles_manager - CREATE OPTIONAL: ", tiles_data, " - ", tiles_count);
 
-    int result = _find_impl(tiles_data, tiles_count);
+    int result = _find_impl(tiles_data, compression, tiles_count);
 
     if(result != -1)
     {
         return result;
     }
 
-    result = _create_impl(tiles_data, tiles_count);
+    result = _create_impl(tiles_ref, compression, tiles_count);
 
     if(result != -1)
     {
@@ -836,17 +1151,17 @@ int create_optional(const span<const tile>& tiles_ref)
     return result;
 }
 
-int create_new_optional(const span<const tile>& tiles_ref)
+int create_new_optional(const span<const tile>& tiles_ref, compression_type compression)
 {
     const tile* tiles_data = tiles_ref.data();
-    int tiles_count = tiles_ref.size();
+    int tiles_count = _tiles_count(tiles_ref, compression);
 
     BN_SPRITE_TILES_LOG("sprite_tiles_manager - CREATE NEW OPTIONAL: ", tiles_data, " - ", tiles_count);
 
     BN_ASSERT(data.items_map.find(tiles_data) == data.items_map.end(),
               "Multiple copies of the same tiles data not supported");
 
-    int result = _create_impl(tiles_data, tiles_count);
+    int result = _create_impl(tiles_ref, compression, tiles_count);
 
     if(result != -1)
     {
@@ -924,6 +1239,11 @@ int tiles_count(int id)
     return data.items.item(id).tiles_count;
 }
 
+compression_type compression(int id)
+{
+    return data.items.item(id).compression();
+}
+
 optional<span<const tile>> tiles_ref(int id)
 {
     const item_type& item = data.items.item(id);
@@ -931,19 +1251,19 @@ optional<span<const tile>> tiles_ref(int id)
 
     if(item.data)
     {
-        result.emplace(item.data, item.tiles_count);
+        result.emplace(item.data, item.data_tiles_count);
     }
 
     return result;
 }
 
-void set_tiles_ref(int id, const span<const tile>& tiles_ref)
+void set_tiles_ref(int id, const span<const tile>& tiles_ref, compression_type compression)
 {
     item_type& item = data.items.item(id);
     const tile* old_tiles_data = item.data;
     [[maybe_unused]] int old_tiles_count = item.tiles_count;
     const tile* new_tiles_data = tiles_ref.data();
-    [[maybe_unused]] int new_tiles_count = tiles_ref.size();
+    [[maybe_unused]] int new_tiles_count = _tiles_count(tiles_ref, compression);
 
     BN_SPRITE_TILES_LOG("sprite_tiles_manager - SET_TILES_REF: ", item.start_tile, " - ", new_tiles_data,
                         " - ", new_tiles_count);
@@ -956,7 +1276,7 @@ void set_tiles_ref(int id, const span<const tile>& tiles_ref)
                   old_tiles_count, " - ", new_tiles_count);
 
         data.items_map.erase(old_tiles_data);
-        _commit_item(new_tiles_data, true, item);
+        _commit_item(tiles_ref, compression, true, item);
         data.items_map.insert(new_tiles_data, id);
 
         BN_SPRITE_TILES_LOG_STATUS();
@@ -999,8 +1319,11 @@ void update()
         auto begin = data.items.begin();
         auto end = data.items.end();
 
-        for(int to_remove_item_index : data.to_remove_items)
+        while(! data.to_remove_items.empty())
         {
+            int to_remove_item_index = data.to_remove_items.front();
+            _erase_to_remove_item(to_remove_item_index);
+
             auto iterator = data.items.it(to_remove_item_index);
             item_type& item = *iterator;
 
@@ -1050,13 +1373,108 @@ void update()
             _insert_free_item(to_remove_item_index);
         }
 
-        data.to_remove_items.clear();
         data.to_remove_tiles_count = 0;
+        data.check_compaction = true;
+
+        BN_SPRITE_TILES_LOG_STATUS();
+    }
+
+    #if BN_CFG_SPRITE_TILES_COMPACTION_THRESHOLD
+        if(data.check_compaction)
+        {
+            constexpr int threshold = BN_CFG_SPRITE_TILES_COMPACTION_THRESHOLD;
+
+            if(data.free_tiles_count >= threshold && available_contiguous_tiles_count() < threshold)
+            {
+                data.compacting = true;
+            }
+        }
+    #endif
+
+    data.check_compaction = false;
+
+    // Tiles are relocated before updating H-Blank effects, so they can write the new tiles ids in the same frame:
+    if(data.compacting)
+    {
+        BN_SPRITE_TILES_LOG("sprite_tiles_manager - UPDATE COMPACTION");
+
+        data.compacting = _compact();
 
         BN_SPRITE_TILES_LOG_STATUS();
     }
 }
 
+bool relocated()
+{
+    return data.relocated;
+}
+
+bool queued_tile([[maybe_unused]] int tile)
+{
+    #if BN_CFG_SPRITE_TILES_MAX_COMMIT_BYTES
+        for(int id : data.queued_new_items)
+        {
+            const item_type& item = data.items.item(id);
+            int start_tile = item.start_tile;
+
+            if(tile >= start_tile && tile < start_tile + int(item.tiles_count))
+            {
+                return true;
+            }
+        }
+    #endif
+
+    return false;
+}
+
+void prepare_commit()
+{
+    #if BN_CFG_SPRITE_TILES_MAX_COMMIT_BYTES
+        data.queued_new_items.clear();
+        data.queued_bytes = 0;
+
+        if(data.check_commit)
+        {
+            int available_bytes = BN_CFG_SPRITE_TILES_MAX_COMMIT_BYTES;
+            bool empty = true;
+
+            // Tiles already in VRAM are uploaded before new ones, since they are already displayed:
+            for(int pass = 0; pass < 2; ++pass)
+            {
+                bool resident = pass == 0;
+
+                for(auto it = data.items.begin(), end = data.items.end(); it != end; ++it)
+                {
+                    item_type& item = *it;
+
+                    if(item.commit && item.resident == resident && item.status() == status_type::USED)
+                    {
+                        int bytes = int(item.tiles_count) * int(sizeof(tile));
+
+                        // Relocated tiles must be uploaded with the sprite handles which reference them:
+                        if(item.relocated || empty || bytes <= available_bytes)
+                        {
+                            available_bytes -= bytes;
+                            item.queued = false;
+                            empty = false;
+                        }
+                        else
+                        {
+                            item.queued = true;
+                            data.queued_bytes += bytes;
+
+                            if(! resident)
+                            {
+                                data.queued_new_items.push_back(uint16_t(it.id()));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    #endif
+}
+
 void commit()
 {
     if(data.check_commit)
@@ -1069,11 +1487,21 @@ void commit()
         {
             if(item.commit)
             {
+                #if BN_CFG_SPRITE_TILES_MAX_COMMIT_BYTES
+                    if(item.queued && item.status() == status_type::USED)
+                    {
+                        data.check_commit = true;
+                        continue;
+                    }
+                #endif
+
                 item.commit = false;
+                item.relocated = false;
 
                 if(item.status() == status_type::USED)
                 {
-                    hw::sprite_tiles::commit(item.data, item.start_tile, item.tiles_count);
+                    hw::sprite_tiles::commit(item.data, item.compression(), item.start_tile, item.tiles_count);
+                    item.resident = true;
                 }
             }
         }
@@ -1082,6 +1510,7 @@ void commit()
     }
 
     data.delay_commit = false;
+    data.relocated = false;
 }
 
 }
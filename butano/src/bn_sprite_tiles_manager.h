@@ -14,6 +14,7 @@ namespace bn
 {
     class tile;
     enum class bpp_mode;
+    enum class compression_type;
 }
 
 namespace bn::sprite_tiles_manager
@@ -24,25 +25,33 @@ namespace bn::sprite_tiles_manager
 
     [[nodiscard]] int available_tiles_count();
 
+    [[nodiscard]] int available_contiguous_tiles_count();
+
     [[nodiscard]] int used_items_count();
 
     [[nodiscard]] int available_items_count();
 
+    [[nodiscard]] int queued_bytes();
+
+    void compact();
+
+    [[nodiscard]] bool compacting();
+
     #if BN_CFG_LOG_ENABLED
         void log_status();
     #endif
 
-    [[nodiscard]] int find(const span<const tile>& tiles_ref);
+    [[nodiscard]] int find(const span<const tile>& tiles_ref, compression_type compression);
 
-    [[nodiscard]] int create(const span<const tile>& tiles_ref);
+    [[nodiscard]] int create(const span<const tile>& tiles_ref, compression_type compression);
 
-    [[nodiscard]] int create_new(const span<const tile>& tiles_ref);
+    [[nodiscard]] int create_new(const span<const tile>& tiles_ref, compression_type compression);
 
     [[nodiscard]] int allocate(int tiles_count, bpp_mode bpp);
 
-    [[nodiscard]] int create_optional(const span<const tile>& tiles_ref);
+    [[nodiscard]] int create_optional(const span<const tile>& tiles_ref, compression_type compression);
 
-    [[nodiscard]] int create_new_optional(const span<const tile>& tiles_ref);
+    [[nodiscard]] int create_new_optional(const span<const tile>& tiles_ref, compression_type compression);
 
     [[nodiscard]] int allocate_optional(int tiles_count, bpp_mode bpp);
 
@@ -54,9 +63,11 @@ namespace bn::sprite_tiles_manager
 
     [[nodiscard]] int tiles_count(int id);
 
+    [[nodiscard]] compression_type compression(int id);
+
     [[nodiscard]] optional<span<const tile>> tiles_ref(int id);
 
-    void set_tiles_ref(int id, const span<const tile>& tiles_ref);
+    void set_tiles_ref(int id, const span<const tile>& tiles_ref, compression_type compression);
 
     void reload_tiles_ref(int id);
 
@@ -64,6 +75,12 @@ namespace bn::sprite_tiles_manager
 
     void update();
 
+    [[nodiscard]] bool relocated();
+
+    [[nodiscard]] bool queued_tile(int tile);
+
+    void prepare_commit();
+
     void commit();
 }
 
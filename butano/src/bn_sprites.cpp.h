@@ -5,6 +5,9 @@
 
 #include "bn_sprites.h"
 
+#include "bn_span.h"
+#include "bn_display.h"
+#include "bn_sprite_ptr.h"
 #include "bn_sprites_manager.h"
 
 namespace bn::sprites
@@ -20,4 +23,87 @@ int available_items_count()
     return sprites_manager::available_items_count();
 }
 
+void set_positions(const span<const sprite_ptr>& sprites, const span<const fixed_point>& positions)
+{
+    BN_ASSERT(sprites.size() == positions.size(), "Invalid positions count: ",
+              sprites.size(), " - ", positions.size());
+
+    sprites_manager::set_positions(sprites, positions);
+}
+
+void set_z_orders(const span<const sprite_ptr>& sprites, const span<const int>& z_orders)
+{
+    BN_ASSERT(sprites.size() == z_orders.size(), "Invalid z orders count: ", sprites.size(), " - ", z_orders.size());
+
+    sprites_manager::set_z_orders(sprites, z_orders);
+}
+
+void set_horizontal_flips(const span<const sprite_ptr>& sprites, const span<const bool>& horizontal_flips)
+{
+    BN_ASSERT(sprites.size() == horizontal_flips.size(), "Invalid horizontal flips count: ",
+              sprites.size(), " - ", horizontal_flips.size());
+
+    sprites_manager::set_horizontal_flips(sprites, horizontal_flips);
+}
+
+void set_vertical_flips(const span<const sprite_ptr>& sprites, const span<const bool>& vertical_flips)
+{
+    BN_ASSERT(sprites.size() == vertical_flips.size(), "Invalid vertical flips count: ",
+              sprites.size(), " - ", vertical_flips.size());
+
+    sprites_manager::set_vertical_flips(sprites, vertical_flips);
+}
+
+#if BN_CFG_SPRITES_SCANLINE_CYCLES_ENABLED
+    int scanline_cycles(int scanline)
+    {
+        BN_ASSERT(scanline >= 0 && scanline < display::height(), "Invalid scanline: ", scanline);
+
+        return sprites_manager::scanline_cycles(scanline);
+    }
+
+    int peak_scanline_cycles()
+    {
+        return sprites_manager::peak_scanline_cycles();
+    }
+
+    bool flicker_enabled()
+    {
+        return sprites_manager::flicker_enabled();
+    }
+
+    void set_flicker_enabled(bool flicker_enabled)
+    {
+        sprites_manager::set_flicker_enabled(flicker_enabled);
+    }
+
+    #if BN_CFG_LOG_ENABLED
+        void log_scanline_cycles()
+        {
+            sprites_manager::log_scanline_cycles();
+        }
+    #endif
+#endif
+
+#if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+    int multiplexing_band_items_count(int band)
+    {
+        BN_ASSERT(band >= 0 && band < multiplexing_bands_count(), "Invalid band: ", band);
+
+        return sprites_manager::multiplexing_band_items_count(band);
+    }
+
+    int multiplexing_dropped_items_count()
+    {
+        return sprites_manager::multiplexing_dropped_items_count();
+    }
+
+    #if BN_CFG_LOG_ENABLED
+        void log_multiplexing_status()
+        {
+            sprites_manager::log_multiplexing_status();
+        }
+    #endif
+#endif
+
 }
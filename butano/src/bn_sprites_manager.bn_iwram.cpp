@@ -6,89 +6,125 @@
 #include "bn_sprites_manager.h"
 
 #include "bn_sorted_sprites.h"
+#include "bn_sprites_manager_hot_fields.h"
+
+#if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+    #include "../hw/include/bn_hw_sprites_multiplexing.h"
+#endif
+
+#if BN_CFG_SPRITES_SCANLINE_CYCLES_ENABLED
+    #include "../hw/include/bn_hw_display_constants.h"
+#endif
 
 namespace bn::sprites_manager
 {
 
-bool _check_items_on_screen_impl(void* hw_handles, intrusive_list<sorted_sprites::layer>& layers,
-                                 bool rebuild_handles, int& first_index_to_commit, int& last_index_to_commit)
+bool _check_items_on_screen_impl(void* hw_handles, sprites_manager_hot_fields& hot_fields, bool rebuild_handles,
+                                 int& first_index_to_commit, int& last_index_to_commit)
 {
     auto handles = reinterpret_cast<hw::sprites::handle_type*>(hw_handles);
+    const int16_t* hw_xs = hot_fields.hw_xs;
+    const int16_t* hw_ys = hot_fields.hw_ys;
+    const uint8_t* widths = hot_fields.widths;
+    const uint8_t* heights = hot_fields.heights;
+    unsigned* check_on_screen_bits = hot_fields.check_on_screen_bits;
+    unsigned* on_screen_bits = hot_fields.on_screen_bits;
     int first_index = first_index_to_commit;
     int last_index = last_index_to_commit;
 
-    for(sorted_sprites::layer& layer : layers)
+    for(int word_index = 0; word_index < sprites_manager_hot_fields::words_count(); ++word_index)
     {
-        for(sprites_manager_item& item : layer.items())
+        unsigned check_on_screen_word = check_on_screen_bits[word_index];
+
+        if(! check_on_screen_word)
+        {
+            continue;
+        }
+
+        unsigned on_screen_word = on_screen_bits[word_index];
+        int hot_index = word_index * 32;
+        check_on_screen_bits[word_index] = 0;
+
+        for(unsigned bit = 1; check_on_screen_word; bit <<= 1, ++hot_index)
         {
-            if(item.check_on_screen)
+            if(! (check_on_screen_word & bit))
             {
-                int x = item.hw_position.x();
-                bool on_screen = false;
-                item.check_on_screen = false;
+                continue;
+            }
 
-                if(x < display::width())
-                {
-                    int y = item.hw_position.y();
+            check_on_screen_word &= ~bit;
+
+            int x = hw_xs[hot_index];
+            bool on_screen = false;
 
-                    if(y < display::height())
+            if(x < display::width())
+            {
+                int y = hw_ys[hot_index];
+
+                if(y < display::height())
+                {
+                    if(x + widths[hot_index] > 0)
                     {
-                        if(x + (item.half_width * 2) > 0)
+                        if(y + heights[hot_index] > 0)
                         {
-                            if(y + (item.half_height * 2) > 0)
-                            {
-                                on_screen = true;
-                            }
+                            on_screen = true;
                         }
                     }
                 }
+            }
+
+            if(bool(on_screen_word & bit) != on_screen)
+            {
+                sprites_manager_item& item = *hot_fields.items[hot_index];
+                item.on_screen = on_screen;
 
-                if(item.on_screen != on_screen)
+                if(on_screen)
                 {
-                    item.on_screen = on_screen;
+                    on_screen_word |= bit;
 
-                    if(on_screen)
+                    if(item.affine_mat)
                     {
-                        if(item.affine_mat)
-                        {
-                            hw::sprites::show_affine(item.double_size, item.handle);
-                        }
-                        else
-                        {
-                            hw::sprites::show_regular(item.handle);
-                        }
+                        hw::sprites::show_affine(item.double_size, item.handle);
                     }
                     else
                     {
-                        hw::sprites::hide(item.handle);
+                        hw::sprites::show_regular(item.handle);
                     }
                 }
-
-                if(! rebuild_handles)
+                else
                 {
-                    int handles_index = item.handles_index;
+                    on_screen_word &= ~bit;
+                    hw::sprites::hide(item.handle);
+                }
+            }
 
-                    if(handles_index != -1)
-                    {
-                        hw::sprites::copy_handle(item.handle, handles[handles_index]);
+            if(! rebuild_handles)
+            {
+                const sprites_manager_item& item = *hot_fields.items[hot_index];
+                int handles_index = item.handles_index;
 
-                        if(handles_index < first_index)
-                        {
-                            first_index = handles_index;
-                        }
+                if(handles_index != -1)
+                {
+                    hw::sprites::copy_handle(item.handle, handles[handles_index]);
 
-                        if(handles_index > last_index)
-                        {
-                            last_index = handles_index;
-                        }
+                    if(handles_index < first_index)
+                    {
+                        first_index = handles_index;
                     }
-                    else
+
+                    if(handles_index > last_index)
                     {
-                        rebuild_handles = true;
+                        last_index = handles_index;
                     }
                 }
+                else
+                {
+                    rebuild_handles = true;
+                }
             }
         }
+
+        on_screen_bits[word_index] = on_screen_word;
     }
 
     first_index_to_commit = first_index;
@@ -97,7 +133,7 @@ bool _check_items_on_screen_impl(void* hw_handles, intrusive_list<sorted_sprites
 }
 
 int _rebuild_handles_impl(int last_visible_items_count, void* hw_handles,
-                          intrusive_list<sorted_sprites::layer>& layers)
+                          sorted_sprites::layers_type& layers)
 {
     auto handles = reinterpret_cast<hw::sprites::handle_type*>(hw_handles);
     int visible_items_count = 0;
@@ -130,21 +166,132 @@ int _rebuild_handles_impl(int last_visible_items_count, void* hw_handles,
     return visible_items_count;
 }
 
-bool _update_cameras_impl(intrusive_list<sorted_sprites::layer>& layers)
+#if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+    int _rebuild_multiplexed_handles_impl(int last_visible_items_count, void* hw_handles,
+                                          sorted_sprites::layers_type& layers,
+                                          hw::sprites_multiplexing::bands& bands, int* band_items_counts,
+                                          int& dropped_items_count)
+    {
+        constexpr int bands_count = hw::sprites_multiplexing::bands_count();
+        constexpr int hw_items_count = hw::sprites::count();
+        constexpr int guard_lines = hw::sprites_multiplexing::guard_lines();
+
+        auto handles = reinterpret_cast<hw::sprites::handle_type*>(hw_handles);
+        uint8_t used_bands[hw_items_count] = {};
+        int first_free_indexes[bands_count] = {};
+        int visible_items_count = 0;
+        int dropped_count = 0;
+        bands.reset();
+
+        for(int band = 0; band < bands_count; ++band)
+        {
+            band_items_counts[band] = 0;
+        }
+
+        for(sorted_sprites::layer& layer : layers)
+        {
+            for(sprites_manager_item& item : layer.items())
+            {
+                item.handles_index = -1;
+                item.multiplexing_dropped = false;
+
+                if(item.on_screen)
+                {
+                    // An OAM entry is busy from the first scanline of the sprite
+                    // until the rewrite of the band which follows its last scanline:
+                    int y = item.hw_position.y();
+                    int top = max(y, 0);
+                    int bottom = min(y + (item.half_height * 2), display::height()) - 1;
+                    int first_band = hw::sprites_multiplexing::band(top);
+                    int last_band = hw::sprites_multiplexing::band(min(bottom + guard_lines, display::height() - 1));
+                    unsigned bands_mask = 0;
+                    int index = 0;
+
+                    for(int band = first_band; band <= last_band; ++band)
+                    {
+                        bands_mask |= 1u << band;
+                        index = max(index, first_free_indexes[band]);
+                    }
+
+                    while(index < hw_items_count && (used_bands[index] & bands_mask))
+                    {
+                        ++index;
+                    }
+
+                    if(index < hw_items_count)
+                    {
+                        used_bands[index] |= uint8_t(bands_mask);
+
+                        for(int band = first_band; band <= last_band; ++band)
+                        {
+                            int& first_free_index = first_free_indexes[band];
+                            ++band_items_counts[band];
+
+                            while(first_free_index < hw_items_count && (used_bands[first_free_index] & (1u << band)))
+                            {
+                                ++first_free_index;
+                            }
+                        }
+
+                        if(first_band)
+                        {
+                            bands.push_back(first_band, index, item.handle);
+                        }
+                        else
+                        {
+                            hw::sprites::copy_handle(item.handle, handles[index]);
+                        }
+
+                        item.handles_index = int8_t(index);
+                        visible_items_count = max(visible_items_count, index + 1);
+                    }
+                    else
+                    {
+                        item.multiplexing_dropped = true;
+                        ++dropped_count;
+                    }
+                }
+            }
+        }
+
+        for(int index = 0; index < visible_items_count; ++index)
+        {
+            if(! (used_bands[index] & 1))
+            {
+                hw::sprites::hide_and_destroy(handles[index]);
+            }
+        }
+
+        for(int index = visible_items_count; index < last_visible_items_count; ++index)
+        {
+            hw::sprites::hide_and_destroy(handles[index]);
+        }
+
+        dropped_items_count = dropped_count;
+        return visible_items_count;
+    }
+#endif
+
+bool _update_camera_impl(int camera_id, sprites_manager_hot_fields& hot_fields)
 {
+    const unsigned* camera_bits = hot_fields.camera_bits[camera_id];
     bool check_items_on_screen = false;
 
-    for(sorted_sprites::layer& layer : layers)
+    for(int word_index = 0; word_index < sprites_manager_hot_fields::words_count(); ++word_index)
     {
-        for(sprites_manager_item& item : layer.items())
+        unsigned camera_word = camera_bits[word_index];
+        int hot_index = word_index * 32;
+
+        for(; camera_word; camera_word >>= 1, ++hot_index)
         {
-            if(item.camera)
+            if(camera_word & 1)
             {
+                sprites_manager_item& item = *hot_fields.items[hot_index];
                 item.update_hw_position();
 
                 if(item.visible)
                 {
-                    item.check_on_screen = true;
+                    hot_fields.set_check_on_screen(item);
                     check_items_on_screen = true;
                 }
             }
@@ -154,4 +301,74 @@ bool _update_cameras_impl(intrusive_list<sorted_sprites::layer>& layers)
     return check_items_on_screen;
 }
 
+
+#if BN_CFG_SPRITES_SCANLINE_CYCLES_ENABLED
+    int _update_scanline_cycles_impl(const sorted_sprites::layers_type& layers, int16_t* scanline_cycles)
+    {
+        constexpr int height = hw::display::height();
+
+        // Each sprite adds its cost to its first scanline and removes it after its last one:
+        int cycles_deltas[height + 1] = {};
+
+        for(const sorted_sprites::layer& layer : layers)
+        {
+            for(const sprites_manager_item& item : layer.items())
+            {
+                if(item.handles_index != -1)
+                {
+                    int width = item.half_width * 2;
+                    int y = item.hw_position.y();
+                    int top = max(y, 0);
+                    int bottom = min(y + (item.half_height * 2), height);
+
+                    if(top < bottom)
+                    {
+                        int cycles = item.affine_mat ? hw::sprites::affine_cycles(width) :
+                                                       hw::sprites::regular_cycles(width);
+                        cycles_deltas[top] += cycles;
+                        cycles_deltas[bottom] -= cycles;
+                    }
+                }
+            }
+        }
+
+        int cycles = 0;
+        int peak_cycles = 0;
+
+        for(int scanline = 0; scanline < height; ++scanline)
+        {
+            cycles += cycles_deltas[scanline];
+            scanline_cycles[scanline] = int16_t(min(cycles, int(numeric_limits<int16_t>::max())));
+            peak_cycles = max(peak_cycles, cycles);
+        }
+
+        return peak_cycles;
+    }
+
+    void _reverse_handles_impl(int visible_items_count, void* hw_handles, sorted_sprites::layers_type& layers)
+    {
+        auto handles = reinterpret_cast<hw::sprites::handle_type*>(hw_handles);
+        int last_index = visible_items_count - 1;
+
+        for(int index = 0, limit = visible_items_count / 2; index < limit; ++index)
+        {
+            hw::sprites::handle_type handle;
+            hw::sprites::copy_handle(handles[index], handle);
+            hw::sprites::copy_handle(handles[last_index - index], handles[index]);
+            hw::sprites::copy_handle(handle, handles[last_index - index]);
+        }
+
+        for(sorted_sprites::layer& layer : layers)
+        {
+            for(sprites_manager_item& item : layer.items())
+            {
+                if(int handles_index = item.handles_index; handles_index != -1)
+                {
+                    item.handles_index = int8_t(last_index - handles_index);
+                }
+            }
+        }
+    }
+#endif
+
 }
@@ -9,6 +9,10 @@
 #include "bn_sprite_first_attributes.h"
 #include "bn_sprite_regular_second_attributes.h"
 #include "bn_sorted_sprites.h"
+#include "bn_sprites_manager_hot_fields.h"
+#include "bn_sprite_particles_manager.h"
+#include "bn_sprite_tiles_manager.h"
+#include "bn_config_sprite_tiles.h"
 #include "../hw/include/bn_hw_sprite_affine_mats_constants.h"
 
 #include "bn_sprites.cpp.h"
@@ -18,6 +22,19 @@
 #include "bn_sprite_third_attributes.cpp.h"
 #include "bn_sprite_affine_second_attributes.cpp.h"
 
+#if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+    #include "../hw/include/bn_hw_sprites_multiplexing.h"
+
+    #if BN_CFG_LOG_ENABLED
+        #include "bn_log.h"
+    #endif
+#endif
+
+#if BN_CFG_SPRITES_SCANLINE_CYCLES_ENABLED && BN_CFG_LOG_ENABLED
+    #include "bn_log.h"
+    #include "bn_string.h"
+#endif
+
 namespace bn::sprites_manager
 {
 
@@ -33,48 +50,189 @@ namespace
 
     public:
         pool<item_type, BN_CFG_SPRITES_MAX_ITEMS> items_pool;
+        vector<int16_t, BN_CFG_SPRITES_MAX_ITEMS> free_hot_indexes;
         hw::sprites::handle_type handles[hw::sprites::count()];
         sorted_sprites::sorter sorter;
         int first_index_to_commit = 0;
         int last_index_to_commit = hw::sprites::count() - 1;
+        int first_index_to_push = 0;
+        int items_count_to_push = 0;
         int last_visible_items_count = 0;
+        int last_particle_handles_end = 0;
+
+        #if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+            hw::sprites_multiplexing::bands multiplexing_bands[2];
+            int multiplexing_band_items_counts[hw::sprites_multiplexing::bands_count()] = {};
+            int multiplexing_dropped_items_count = 0;
+            int8_t multiplexing_bands_index = 0;
+            bool commit_multiplexing_bands = false;
+        #endif
+
+        #if BN_CFG_SPRITES_SCANLINE_CYCLES_ENABLED
+            int16_t scanline_cycles[display::height()] = {};
+            int peak_scanline_cycles = 0;
+            bool flicker_enabled = false;
+            bool flicker_reversed = false;
+        #endif
+
         bool check_items_on_screen = false;
         bool rebuild_handles = false;
     };
 
     BN_DATA_EWRAM static_data data;
 
-    void _update_indexes_to_commit(const item_type& item)
+    // Packed copy of the fields read by the culling and camera passes (stored in IWRAM):
+    sprites_manager_hot_fields hot_fields;
+
+    void _insert_item(item_type& item)
+    {
+        item.hot_index = data.free_hot_indexes.back();
+        data.free_hot_indexes.pop_back();
+        data.sorter.insert(item);
+        hot_fields.add(item);
+    }
+
+    void _update_indexes_to_commit(const item_type& item, int& first_index_to_commit, int& last_index_to_commit)
     {
         int handles_index = item.handles_index;
 
         if(handles_index != -1)
         {
-            hw::sprites::copy_handle(item.handle, data.handles[handles_index]);
-
-            if(handles_index < data.first_index_to_commit)
-            {
-                data.first_index_to_commit = handles_index;
-            }
-
-            if(handles_index > data.last_index_to_commit)
-            {
-                data.last_index_to_commit = handles_index;
-            }
+            #if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+                // OAM entries are shared between bands, so they can't be updated in place:
+                data.rebuild_handles = true;
+                static_cast<void>(first_index_to_commit);
+                static_cast<void>(last_index_to_commit);
+            #else
+                hw::sprites::copy_handle(item.handle, data.handles[handles_index]);
+
+                if(handles_index < first_index_to_commit)
+                {
+                    first_index_to_commit = handles_index;
+                }
+
+                if(handles_index > last_index_to_commit)
+                {
+                    last_index_to_commit = handles_index;
+                }
+            #endif
         }
     }
 
+    void _update_indexes_to_commit(const item_type& item)
+    {
+        _update_indexes_to_commit(item, data.first_index_to_commit, data.last_index_to_commit);
+    }
+
     void _update_item_dimensions(item_type& item)
     {
         item.update_half_dimensions();
 
         if(item.visible)
         {
-            item.check_on_screen = true;
+            hot_fields.set_check_on_screen(item);
             data.check_items_on_screen = true;
         }
     }
 
+    [[nodiscard]] bool _set_position(item_type& item, const fixed_point& position)
+    {
+        fixed_point old_position = item.position;
+        item.position = position;
+
+        point old_integer_position(old_position.x().right_shift_integer(), old_position.y().right_shift_integer());
+        point new_integer_position(position.x().right_shift_integer(), position.y().right_shift_integer());
+        point diff = new_integer_position - old_integer_position;
+
+        if(diff == point())
+        {
+            return false;
+        }
+
+        point hw_position = item.hw_position + diff;
+        item.hw_position = hw_position;
+
+        hw::sprites::handle_type& handle = item.handle;
+        hw::sprites::set_x(hw_position.x(), handle);
+        hw::sprites::set_y(hw_position.y(), handle);
+
+        if(! item.visible)
+        {
+            return false;
+        }
+
+        hot_fields.set_check_on_screen(item);
+        return true;
+    }
+
+    #if BN_CFG_SPRITES_AFFINE_MATS_INTERNING_ENABLED
+        void _set_interned_affine_mat(item_type& item, const affine_mat_attributes& attributes);
+    #endif
+
+    [[nodiscard]] bool _set_horizontal_flip(item_type& item, bool horizontal_flip)
+    {
+        if(item.affine_mat)
+        {
+            #if BN_CFG_SPRITES_AFFINE_MATS_INTERNING_ENABLED
+                if(item.affine_mat->_interned())
+                {
+                    // Shared affine mats can't be modified in place:
+                    affine_mat_attributes mat_attributes = item.affine_mat->attributes();
+                    mat_attributes.set_horizontal_flip(horizontal_flip);
+                    _set_interned_affine_mat(item, mat_attributes);
+                    return false;
+                }
+            #endif
+
+            item.affine_mat->set_horizontal_flip(horizontal_flip);
+            return false;
+        }
+
+        hw::sprites::handle_type& handle = item.handle;
+
+        if(horizontal_flip == hw::sprites::horizontal_flip(handle))
+        {
+            return false;
+        }
+
+        hw::sprites::set_horizontal_flip(horizontal_flip, handle);
+        return true;
+    }
+
+    [[nodiscard]] bool _set_vertical_flip(item_type& item, bool vertical_flip)
+    {
+        if(item.affine_mat)
+        {
+            #if BN_CFG_SPRITES_AFFINE_MATS_INTERNING_ENABLED
+                if(item.affine_mat->_interned())
+                {
+                    affine_mat_attributes mat_attributes = item.affine_mat->attributes();
+                    mat_attributes.set_vertical_flip(vertical_flip);
+                    _set_interned_affine_mat(item, mat_attributes);
+                    return false;
+                }
+            #endif
+
+            item.affine_mat->set_vertical_flip(vertical_flip);
+            return false;
+        }
+
+        hw::sprites::handle_type& handle = item.handle;
+
+        if(vertical_flip == hw::sprites::vertical_flip(handle))
+        {
+            return false;
+        }
+
+        hw::sprites::set_vertical_flip(vertical_flip, handle);
+        return true;
+    }
+
+    [[nodiscard]] item_type& _item(const sprite_ptr& sprite)
+    {
+        return *static_cast<item_type*>(const_cast<void*>(sprite.handle()));
+    }
+
     void _assign_affine_mat(item_type& item, sprite_affine_mat_ptr&& affine_mat)
     {
         if(item.affine_mat)
@@ -121,13 +279,88 @@ namespace
         }
     }
 
+    #if BN_CFG_SPRITES_AFFINE_MATS_INTERNING_ENABLED
+        void _set_interned_affine_mat(item_type& item, const affine_mat_attributes& attributes)
+        {
+            if(attributes.flipped_identity())
+            {
+                if(! item.affine_mat)
+                {
+                    return;
+                }
+
+                if(item.remove_affine_mat_when_not_needed)
+                {
+                    _remove_affine_mat(item);
+
+                    bool horizontal_flip_updated = _set_horizontal_flip(item, attributes.horizontal_flip());
+                    bool vertical_flip_updated = _set_vertical_flip(item, attributes.vertical_flip());
+
+                    if(horizontal_flip_updated || vertical_flip_updated)
+                    {
+                        _update_indexes_to_commit(item);
+                    }
+
+                    return;
+                }
+            }
+            else if(! item.affine_mat)
+            {
+                item.remove_affine_mat_when_not_needed = true;
+            }
+
+            sprite_affine_mat_ptr affine_mat = sprite_affine_mat_ptr::_create_interned(attributes);
+
+            if(item.affine_mat != affine_mat)
+            {
+                _assign_affine_mat(item, move(affine_mat));
+            }
+        }
+    #endif
+
     void _rebuild_handles()
     {
+        #if BN_CFG_SPRITES_SCANLINE_CYCLES_ENABLED && ! BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+            // OAM order must be reversed every frame while a scanline is overflowed:
+            bool flicker = data.flicker_enabled && data.peak_scanline_cycles > hw::sprites::max_scanline_cycles();
+
+            if(flicker || data.flicker_reversed)
+            {
+                data.rebuild_handles = true;
+            }
+        #endif
+
         if(data.rebuild_handles)
         {
             hw::sprites::handle_type* handles = data.handles;
             int last_visible_items_count = data.last_visible_items_count;
-            int visible_items_count = _rebuild_handles_impl(last_visible_items_count, handles, data.sorter.layers());
+
+            #if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+                hw::sprites_multiplexing::bands& next_bands =
+                        data.multiplexing_bands[(data.multiplexing_bands_index + 1) % 2];
+                int visible_items_count = _rebuild_multiplexed_handles_impl(
+                            last_visible_items_count, handles, data.sorter.layers(), next_bands,
+                            data.multiplexing_band_items_counts, data.multiplexing_dropped_items_count);
+                data.commit_multiplexing_bands = true;
+            #else
+                int visible_items_count = _rebuild_handles_impl(last_visible_items_count, handles,
+                                                                data.sorter.layers());
+
+                #if BN_CFG_SPRITES_SCANLINE_CYCLES_ENABLED
+                    bool flicker_reversed = flicker && ! data.flicker_reversed;
+                    data.flicker_reversed = flicker_reversed;
+
+                    if(flicker_reversed)
+                    {
+                        _reverse_handles_impl(visible_items_count, handles, data.sorter.layers());
+                    }
+                #endif
+            #endif
+
+            #if BN_CFG_SPRITES_SCANLINE_CYCLES_ENABLED
+                data.peak_scanline_cycles = _update_scanline_cycles_impl(data.sorter.layers(), data.scanline_cycles);
+            #endif
+
             int to_commit_items_count = max(visible_items_count, last_visible_items_count);
             data.rebuild_handles = false;
             data.last_visible_items_count = visible_items_count;
@@ -146,7 +379,14 @@ namespace
         {
             data.check_items_on_screen = false;
 
-            if(_check_items_on_screen_impl(data.handles, data.sorter.layers(), data.rebuild_handles,
+            #if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+                // Sprites must be placed again in the multiplexing bands when their position changes:
+                bool rebuild_handles = true;
+            #else
+                bool rebuild_handles = data.rebuild_handles;
+            #endif
+
+            if(_check_items_on_screen_impl(data.handles, hot_fields, rebuild_handles,
                                            data.first_index_to_commit, data.last_index_to_commit))
             {
                 data.rebuild_handles = true;
@@ -162,7 +402,16 @@ void init()
         hw::sprites::hide_and_destroy(handle);
     }
 
+    for(int index = BN_CFG_SPRITES_MAX_ITEMS - 1; index >= 0; --index)
+    {
+        data.free_hot_indexes.push_back(int16_t(index));
+    }
+
     sprite_affine_mats_manager::init(sizeof(data.handles), data.handles);
+
+    #if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+        hw::sprites_multiplexing::init(data.multiplexing_bands[0]);
+    #endif
 }
 
 int used_items_count()
@@ -175,13 +424,118 @@ int available_items_count()
     return data.items_pool.available();
 }
 
+#if BN_CFG_SPRITES_SCANLINE_CYCLES_ENABLED
+    int scanline_cycles(int scanline)
+    {
+        return data.scanline_cycles[scanline];
+    }
+
+    int peak_scanline_cycles()
+    {
+        return data.peak_scanline_cycles;
+    }
+
+    bool flicker_enabled()
+    {
+        return data.flicker_enabled;
+    }
+
+    void set_flicker_enabled(bool flicker_enabled)
+    {
+        data.flicker_enabled = flicker_enabled;
+    }
+
+    #if BN_CFG_LOG_ENABLED
+        void log_scanline_cycles()
+        {
+            constexpr int scanlines_per_row = 8;
+            constexpr int bar_max_size = 24;
+
+            BN_LOG("peak_scanline_cycles: ", data.peak_scanline_cycles, " - max: ", hw::sprites::max_scanline_cycles());
+            BN_LOG('[');
+
+            for(int row_scanline = 0; row_scanline < display::height(); row_scanline += scanlines_per_row)
+            {
+                int cycles = 0;
+
+                for(int scanline = row_scanline; scanline < row_scanline + scanlines_per_row; ++scanline)
+                {
+                    cycles = max(cycles, int(data.scanline_cycles[scanline]));
+                }
+
+                int bar_size = min((cycles * bar_max_size) / hw::sprites::max_scanline_cycles(), bar_max_size);
+                string<bar_max_size + 1> bar(bar_size, '#');
+
+                if(cycles > hw::sprites::max_scanline_cycles())
+                {
+                    bar.push_back('!');
+                }
+
+                BN_LOG("    ", row_scanline, ": ", bar, ' ', cycles);
+            }
+
+            BN_LOG(']');
+        }
+    #endif
+#endif
+
+#if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+    int multiplexing_band_items_count(int band)
+    {
+        return data.multiplexing_band_items_counts[band];
+    }
+
+    int multiplexing_dropped_items_count()
+    {
+        return data.multiplexing_dropped_items_count;
+    }
+
+    #if BN_CFG_LOG_ENABLED
+        void log_multiplexing_status()
+        {
+            BN_LOG("bands: ", hw::sprites_multiplexing::bands_count());
+            BN_LOG('[');
+
+            for(int band = 0; band < hw::sprites_multiplexing::bands_count(); ++band)
+            {
+                BN_LOG("    ",
+                        "band: ", band,
+                        " - top: ", hw::sprites_multiplexing::band_top(band),
+                        " - items_count: ", data.multiplexing_band_items_counts[band]);
+            }
+
+            BN_LOG(']');
+
+            BN_LOG("dropped_items: ", data.multiplexing_dropped_items_count);
+            BN_LOG('[');
+
+            for(const sorted_sprites::layer& layer : data.sorter.layers())
+            {
+                for(const item_type& item : layer.items())
+                {
+                    if(item.multiplexing_dropped)
+                    {
+                        BN_LOG("    ",
+                                "id: ", &item,
+                                " - hw_position: ", item.hw_position.x(), ", ", item.hw_position.y(),
+                                " - bg_priority: ", item.bg_priority(),
+                                " - z_order: ", item.z_order());
+                    }
+                }
+            }
+
+            BN_LOG(']');
+        }
+    #endif
+#endif
+
 id_type create(const fixed_point& position, const sprite_shape_size& shape_size, sprite_tiles_ptr&& tiles,
                sprite_palette_ptr&& palette)
 {
     BN_ASSERT(! data.items_pool.full(), "No more sprite items available");
 
     item_type& new_item = data.items_pool.create(position, shape_size, move(tiles), move(palette));
-    data.sorter.insert(new_item);
+    _insert_item(new_item);
     data.check_items_on_screen = true;
     data.rebuild_handles = true;
     return &new_item;
@@ -196,7 +550,7 @@ id_type create_optional(const fixed_point& position, const sprite_shape_size& sh
     }
 
     item_type& new_item = data.items_pool.create(position, shape_size, move(tiles), move(palette));
-    data.sorter.insert(new_item);
+    _insert_item(new_item);
     data.check_items_on_screen = true;
     data.rebuild_handles = true;
     return &new_item;
@@ -209,7 +563,7 @@ id_type create(sprite_builder&& builder)
     sprite_tiles_ptr tiles = builder.release_tiles();
     sprite_palette_ptr palette = builder.release_palette();
     item_type& new_item = data.items_pool.create(move(builder), move(tiles), move(palette));
-    data.sorter.insert(new_item);
+    _insert_item(new_item);
 
     if(new_item.visible)
     {
@@ -242,7 +596,7 @@ id_type create_optional(sprite_builder&& builder)
     }
 
     item_type& new_item = data.items_pool.create(move(builder), move(*tiles), move(*palette));
-    data.sorter.insert(new_item);
+    _insert_item(new_item);
 
     if(new_item.visible)
     {
@@ -267,6 +621,8 @@ void decrease_usages(id_type id)
     if(! item->usages)
     {
         data.sorter.erase(*item);
+        hot_fields.remove(*item);
+        data.free_hot_indexes.push_back(item->hot_index);
 
         if(item->affine_mat)
         {
@@ -527,7 +883,7 @@ void set_x(id_type id, fixed x)
 
         if(item->visible)
         {
-            item->check_on_screen = true;
+            hot_fields.set_check_on_screen(*item);
             data.check_items_on_screen = true;
         }
     }
@@ -551,7 +907,7 @@ void set_y(id_type id, fixed y)
 
         if(item->visible)
         {
-            item->check_on_screen = true;
+            hot_fields.set_check_on_screen(*item);
             data.check_items_on_screen = true;
         }
     }
@@ -560,27 +916,27 @@ void set_y(id_type id, fixed y)
 void set_position(id_type id, const fixed_point& position)
 {
     auto item = static_cast<item_type*>(id);
-    fixed_point old_position = item->position;
-    item->position = position;
-
-    point old_integer_position(old_position.x().right_shift_integer(), old_position.y().right_shift_integer());
-    point new_integer_position(position.x().right_shift_integer(), position.y().right_shift_integer());
-    point diff = new_integer_position - old_integer_position;
 
-    if(diff != point())
+    if(_set_position(*item, position))
     {
-        point hw_position = item->hw_position + diff;
-        item->hw_position = hw_position;
+        data.check_items_on_screen = true;
+    }
+}
 
-        hw::sprites::handle_type& handle = item->handle;
-        hw::sprites::set_x(hw_position.x(), handle);
-        hw::sprites::set_y(hw_position.y(), handle);
+void set_positions(const span<const sprite_ptr>& sprites, const span<const fixed_point>& positions)
+{
+    const sprite_ptr* sprites_data = sprites.data();
+    const fixed_point* positions_data = positions.data();
+    bool check_items_on_screen = false;
 
-        if(item->visible)
-        {
-            item->check_on_screen = true;
-            data.check_items_on_screen = true;
-        }
+    for(int index = 0, limit = sprites.size(); index < limit; ++index)
+    {
+        check_items_on_screen |= _set_position(_item(sprites_data[index]), positions_data[index]);
+    }
+
+    if(check_items_on_screen)
+    {
+        data.check_items_on_screen = true;
     }
 }
 
@@ -599,9 +955,7 @@ void set_bg_priority(id_type id, int bg_priority)
         BN_ASSERT(bg_priority >= 0 && bg_priority <= sprites::max_bg_priority(), "Invalid BG priority: ", bg_priority);
 
         hw::sprites::set_bg_priority(bg_priority, item->handle);
-        data.sorter.erase(*item);
-        item->set_bg_priority(bg_priority);
-        data.sorter.insert(*item);
+        data.sorter.change_sort_key(*item, sort_key(bg_priority, item->z_order()));
         data.rebuild_handles = true;
     }
 }
@@ -618,9 +972,31 @@ void set_z_order(id_type id, int z_order)
 
     if(z_order != item->z_order())
     {
-        data.sorter.erase(*item);
-        item->set_z_order(z_order);
-        data.sorter.insert(*item);
+        data.sorter.change_sort_key(*item, sort_key(item->bg_priority(), z_order));
+        data.rebuild_handles = true;
+    }
+}
+
+void set_z_orders(const span<const sprite_ptr>& sprites, const span<const int>& z_orders)
+{
+    const sprite_ptr* sprites_data = sprites.data();
+    const int* z_orders_data = z_orders.data();
+    bool rebuild_handles = false;
+
+    for(int index = 0, limit = sprites.size(); index < limit; ++index)
+    {
+        item_type& item = _item(sprites_data[index]);
+        int z_order = z_orders_data[index];
+
+        if(z_order != item.z_order())
+        {
+            data.sorter.change_sort_key(item, sort_key(item.bg_priority(), z_order));
+            rebuild_handles = true;
+        }
+    }
+
+    if(rebuild_handles)
+    {
         data.rebuild_handles = true;
     }
 }
@@ -629,7 +1005,7 @@ void put_above(id_type id)
 {
     auto item = static_cast<item_type*>(id);
 
-    if(sorted_sprites::sorter::put_in_front_of_layer(*item))
+    if(data.sorter.put_in_front_of_layer(*item))
     {
         data.rebuild_handles = true;
     }
@@ -651,20 +1027,33 @@ void set_horizontal_flip(id_type id, bool horizontal_flip)
 {
     auto item = static_cast<item_type*>(id);
 
-    if(item->affine_mat)
+    if(_set_horizontal_flip(*item, horizontal_flip))
     {
-        item->affine_mat->set_horizontal_flip(horizontal_flip);
+        _update_indexes_to_commit(*item);
     }
-    else
+}
+
+void set_horizontal_flips(const span<const sprite_ptr>& sprites, const span<const bool>& horizontal_flips)
+{
+    const sprite_ptr* sprites_data = sprites.data();
+    const bool* horizontal_flips_data = horizontal_flips.data();
+
+    int first_index_to_commit = data.first_index_to_commit;
+    int last_index_to_commit = data.last_index_to_commit;
+
+    for(int index = 0, limit = sprites.size(); index < limit; ++index)
     {
-        hw::sprites::handle_type& handle = item->handle;
+        item_type& item = _item(sprites_data[index]);
 
-        if(horizontal_flip != hw::sprites::horizontal_flip(handle))
+        if(_set_horizontal_flip(item, horizontal_flips_data[index]))
         {
-            hw::sprites::set_horizontal_flip(horizontal_flip, handle);
-            _update_indexes_to_commit(*item);
+            _update_indexes_to_commit(item, first_index_to_commit, last_index_to_commit);
         }
     }
+
+    // Shared affine mats updates can modify the commit range inside the loop:
+    data.first_index_to_commit = min(data.first_index_to_commit, first_index_to_commit);
+    data.last_index_to_commit = max(data.last_index_to_commit, last_index_to_commit);
 }
 
 bool vertical_flip(id_type id)
@@ -683,20 +1072,33 @@ void set_vertical_flip(id_type id, bool vertical_flip)
 {
     auto item = static_cast<item_type*>(id);
 
-    if(item->affine_mat)
+    if(_set_vertical_flip(*item, vertical_flip))
     {
-        item->affine_mat->set_vertical_flip(vertical_flip);
+        _update_indexes_to_commit(*item);
     }
-    else
+}
+
+void set_vertical_flips(const span<const sprite_ptr>& sprites, const span<const bool>& vertical_flips)
+{
+    const sprite_ptr* sprites_data = sprites.data();
+    const bool* vertical_flips_data = vertical_flips.data();
+
+    int first_index_to_commit = data.first_index_to_commit;
+    int last_index_to_commit = data.last_index_to_commit;
+
+    for(int index = 0, limit = sprites.size(); index < limit; ++index)
     {
-        hw::sprites::handle_type& handle = item->handle;
+        item_type& item = _item(sprites_data[index]);
 
-        if(vertical_flip != hw::sprites::vertical_flip(handle))
+        if(_set_vertical_flip(item, vertical_flips_data[index]))
         {
-            hw::sprites::set_vertical_flip(vertical_flip, handle);
-            _update_indexes_to_commit(*item);
+            _update_indexes_to_commit(item, first_index_to_commit, last_index_to_commit);
         }
     }
+
+    // Shared affine mats updates can modify the commit range inside the loop:
+    data.first_index_to_commit = min(data.first_index_to_commit, first_index_to_commit);
+    data.last_index_to_commit = max(data.last_index_to_commit, last_index_to_commit);
 }
 
 bool mosaic_enabled(id_type id)
@@ -812,14 +1214,14 @@ void set_visible(id_type id, bool visible)
 
         if(visible)
         {
-            item->check_on_screen = true;
+            hot_fields.set_check_on_screen(*item);
             data.check_items_on_screen = true;
         }
         else
         {
             hw::sprites::hide(item->handle);
             item->on_screen = false;
-            item->check_on_screen = false;
+            hot_fields.hide(*item);
             _update_indexes_to_commit(*item);
         }
     }
@@ -839,10 +1241,11 @@ void set_camera(id_type id, camera_ptr&& camera)
     {
         item->camera = move(camera);
         item->update_hw_position();
+        hot_fields.set_camera(*item);
 
         if(item->visible)
         {
-            item->check_on_screen = true;
+            hot_fields.set_check_on_screen(*item);
             data.check_items_on_screen = true;
         }
     }
@@ -856,10 +1259,11 @@ void remove_camera(id_type id)
     {
         item->camera.reset();
         item->update_hw_position();
+        hot_fields.set_camera(*item);
 
         if(item->visible)
         {
-            item->check_on_screen = true;
+            hot_fields.set_check_on_screen(*item);
             data.check_items_on_screen = true;
         }
     }
@@ -913,6 +1317,37 @@ void set_remove_affine_mat_when_not_needed(id_type id, bool remove_when_not_need
     item->remove_affine_mat_when_not_needed = remove_when_not_needed;
 }
 
+#if BN_CFG_SPRITES_AFFINE_MATS_INTERNING_ENABLED
+    bool interned_affine_mat_attributes(id_type id, affine_mat_attributes& attributes)
+    {
+        auto item = static_cast<const item_type*>(id);
+
+        if(const optional<sprite_affine_mat_ptr>& affine_mat = item->affine_mat)
+        {
+            if(! affine_mat->_interned())
+            {
+                return false;
+            }
+
+            attributes = affine_mat->attributes();
+        }
+        else
+        {
+            attributes = affine_mat_attributes();
+            attributes.set_horizontal_flip(hw::sprites::horizontal_flip(item->handle));
+            attributes.set_vertical_flip(hw::sprites::vertical_flip(item->handle));
+        }
+
+        return true;
+    }
+
+    void set_interned_affine_mat(id_type id, const affine_mat_attributes& attributes)
+    {
+        auto item = static_cast<item_type*>(id);
+        _set_interned_affine_mat(*item, attributes);
+    }
+#endif
+
 sprite_first_attributes first_attributes(id_type id)
 {
     auto item = static_cast<const item_type*>(id);
@@ -1163,9 +1598,9 @@ void fill_hblank_effect_third_attributes([[maybe_unused]] sprite_shape_size shap
     }
 }
 
-void update_cameras()
+void update_camera(int camera_id)
 {
-    data.check_items_on_screen |= _update_cameras_impl(data.sorter.layers());
+    data.check_items_on_screen |= _update_camera_impl(camera_id, hot_fields);
 }
 
 void remove_identity_affine_mat_if_not_needed(id_type id)
@@ -1195,15 +1630,107 @@ void update_affine_mat_double_size(id_type id, bool new_double_size)
 
 void update()
 {
+    #if BN_CFG_SPRITES_BATCHED_SORT_ENABLED
+        data.sorter.sort();
+    #endif
+
     sprite_affine_mats_manager::update();
     _check_items_on_screen();
     _rebuild_handles();
 }
 
-void commit()
+void prepare_commit()
 {
+    // Relocated sprite tiles are uploaded in the next V-Blank, so the handles must be updated in the same one:
+    if(sprite_tiles_manager::relocated())
+    {
+        for(sorted_sprites::layer& layer : data.sorter.layers())
+        {
+            for(item_type& item : layer.items())
+            {
+                if(const optional<sprite_tiles_ptr>& tiles = item.tiles)
+                {
+                    int tiles_id = tiles->id();
+
+                    if(hw::sprites::tiles_id(item.handle) != tiles_id)
+                    {
+                        hw::sprites::set_tiles(tiles_id, item.handle);
+                        _update_indexes_to_commit(item);
+                    }
+                }
+            }
+        }
+
+        #if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+            _rebuild_handles();
+        #endif
+    }
+
+    #if BN_CFG_SPRITE_TILES_MAX_COMMIT_BYTES
+        // Sprites with tiles queued for the next V-Blanks are hidden until the next handles rebuild:
+        if(sprite_tiles_manager::queued_bytes())
+        {
+            for(int index = 0, limit = data.last_visible_items_count; index < limit; ++index)
+            {
+                hw::sprites::handle_type& handle = data.handles[index];
+
+                if(sprite_tiles_manager::queued_tile(hw::sprites::tiles_id(handle)))
+                {
+                    hw::sprites::hide(handle);
+                    data.first_index_to_commit = min(data.first_index_to_commit, index);
+                    data.last_index_to_commit = max(data.last_index_to_commit, index);
+                    data.rebuild_handles = true;
+                }
+            }
+
+            #if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+                // The entries of the bands displayed in the next frame are hidden too:
+                int8_t bands_index = data.multiplexing_bands_index;
+
+                if(data.commit_multiplexing_bands)
+                {
+                    bands_index = int8_t((bands_index + 1) % 2);
+                }
+
+                for(hw::sprites_multiplexing::band_entries& band_entries : data.multiplexing_bands[bands_index].items)
+                {
+                    for(int index = 0, limit = band_entries.entries_count; index < limit; ++index)
+                    {
+                        hw::sprites_multiplexing::entry& entry = band_entries.entries[index];
+
+                        if(sprite_tiles_manager::queued_tile(BFN_GET(entry.attr2, ATTR2_ID)))
+                        {
+                            hw::sprites::hide(entry.attr0);
+                            data.rebuild_handles = true;
+                        }
+                    }
+                }
+            #endif
+        }
+    #endif
+
+    // Particles are written in the OAM entries which are not used by the visible sprites:
+    int particle_handles_begin = data.last_visible_items_count;
+    int max_particle_handles = min(hw::sprites::count() - particle_handles_begin, BN_CFG_SPRITES_MAX_PARTICLE_HANDLES);
+    int particle_handles_end = particle_handles_begin + sprite_particles_manager::write_handles(
+                max_particle_handles, data.handles + particle_handles_begin);
+    int last_particle_handles_end = data.last_particle_handles_end;
+    data.last_particle_handles_end = particle_handles_end;
+
+    for(int index = particle_handles_end; index < last_particle_handles_end; ++index)
+    {
+        hw::sprites::hide_and_destroy(data.handles[index]);
+    }
+
     int first_index_to_commit = data.first_index_to_commit;
     int last_index_to_commit = data.last_index_to_commit;
+    int particles_last_index_to_commit = max(particle_handles_end, last_particle_handles_end) - 1;
+
+    if(particles_last_index_to_commit >= particle_handles_begin)
+    {
+        first_index_to_commit = min(first_index_to_commit, particle_handles_begin);
+        last_index_to_commit = max(last_index_to_commit, particles_last_index_to_commit);
+    }
 
     if(auto affine_mats_commit_data = sprite_affine_mats_manager::retrieve_commit_data())
     {
@@ -1214,13 +1741,57 @@ void commit()
         last_index_to_commit = max(last_index_to_commit, last_mat_index_to_commit);
     }
 
+    #if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+        // OAM entries overwritten in the last frame must be restored:
+        hw::sprites_multiplexing::bands& current_bands = data.multiplexing_bands[data.multiplexing_bands_index];
+
+        if(! current_bands.empty())
+        {
+            first_index_to_commit = min(first_index_to_commit, current_bands.first_index);
+            last_index_to_commit = max(last_index_to_commit, current_bands.last_index);
+        }
+    #endif
+
     if(first_index_to_commit < hw::sprites::count())
     {
-        int commit_items_count = last_index_to_commit - first_index_to_commit + 1;
-        hw::sprites::commit(data.handles[0], first_index_to_commit, commit_items_count);
+        data.first_index_to_push = first_index_to_commit;
+        data.items_count_to_push = last_index_to_commit - first_index_to_commit + 1;
         data.first_index_to_commit = hw::sprites::count();
         data.last_index_to_commit = 0;
     }
+    else
+    {
+        data.items_count_to_push = 0;
+    }
+}
+
+void commit()
+{
+    if(int items_count = data.items_count_to_push)
+    {
+        hw::sprites::commit(data.handles[0], data.first_index_to_push, items_count);
+        data.items_count_to_push = 0;
+    }
+
+    #if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+        if(data.commit_multiplexing_bands)
+        {
+            int8_t bands_index = (data.multiplexing_bands_index + 1) % 2;
+            const hw::sprites_multiplexing::bands& next_bands = data.multiplexing_bands[bands_index];
+            data.multiplexing_bands_index = bands_index;
+            data.commit_multiplexing_bands = false;
+            hw::sprites_multiplexing::commit_bands(next_bands);
+
+            if(next_bands.empty())
+            {
+                hw::sprites_multiplexing::disable();
+            }
+            else
+            {
+                hw::sprites_multiplexing::enable();
+            }
+        }
+    #endif
 }
 
 }
@@ -6,6 +6,9 @@
 #ifndef BN_SPRITES_MANAGER_H
 #define BN_SPRITES_MANAGER_H
 
+#include "bn_config_log.h"
+#include "bn_config_sprites.h"
+#include "bn_span_fwd.h"
 #include "bn_fixed_fwd.h"
 #include "bn_optional_fwd.h"
 #include "bn_intrusive_list_fwd.h"
@@ -16,16 +19,19 @@ namespace bn
 class size;
 class point;
 class camera_ptr;
+class sprite_ptr;
 class fixed_point;
 class sprite_builder;
 class sprite_tiles_ptr;
 class sprite_shape_size;
 class sprite_palette_ptr;
 class sprite_affine_mat_ptr;
+class affine_mat_attributes;
 class sprite_first_attributes;
 class sprite_third_attributes;
 class sprite_regular_second_attributes;
 class sprite_affine_second_attributes;
+class sprites_manager_hot_fields;
 enum class bpp_mode;
 enum class sprite_size;
 enum class sprite_shape;
@@ -34,6 +40,17 @@ enum class sprite_double_size_mode;
 namespace sorted_sprites
 {
     class layer;
+
+    #if BN_CFG_SPRITES_BATCHED_SORT_ENABLED
+        using layers_type = span<layer>;
+    #else
+        using layers_type = intrusive_list<layer>;
+    #endif
+}
+
+namespace hw::sprites_multiplexing
+{
+    class bands;
 }
 
 namespace sprites_manager
@@ -46,6 +63,30 @@ namespace sprites_manager
 
     [[nodiscard]] int available_items_count();
 
+    #if BN_CFG_SPRITES_SCANLINE_CYCLES_ENABLED
+        [[nodiscard]] int scanline_cycles(int scanline);
+
+        [[nodiscard]] int peak_scanline_cycles();
+
+        [[nodiscard]] bool flicker_enabled();
+
+        void set_flicker_enabled(bool flicker_enabled);
+
+        #if BN_CFG_LOG_ENABLED
+            void log_scanline_cycles();
+        #endif
+    #endif
+
+    #if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+        [[nodiscard]] int multiplexing_band_items_count(int band);
+
+        [[nodiscard]] int multiplexing_dropped_items_count();
+
+        #if BN_CFG_LOG_ENABLED
+            void log_multiplexing_status();
+        #endif
+    #endif
+
     [[nodiscard]] id_type create(const fixed_point& position, const sprite_shape_size& shape_size,
                                  sprite_tiles_ptr&& tiles, sprite_palette_ptr&& palette);
 
@@ -103,6 +144,8 @@ namespace sprites_manager
 
     void set_position(id_type id, const fixed_point& position);
 
+    void set_positions(const span<const sprite_ptr>& sprites, const span<const fixed_point>& positions);
+
     [[nodiscard]] int bg_priority(id_type id);
 
     void set_bg_priority(id_type id, int bg_priority);
@@ -111,16 +154,22 @@ namespace sprites_manager
 
     void set_z_order(id_type id, int z_order);
 
+    void set_z_orders(const span<const sprite_ptr>& sprites, const span<const int>& z_orders);
+
     void put_above(id_type id);
 
     [[nodiscard]] bool horizontal_flip(id_type id);
 
     void set_horizontal_flip(id_type id, bool horizontal_flip);
 
+    void set_horizontal_flips(const span<const sprite_ptr>& sprites, const span<const bool>& horizontal_flips);
+
     [[nodiscard]] bool vertical_flip(id_type id);
 
     void set_vertical_flip(id_type id, bool vertical_flip);
 
+    void set_vertical_flips(const span<const sprite_ptr>& sprites, const span<const bool>& vertical_flips);
+
     [[nodiscard]] bool mosaic_enabled(id_type id);
 
     void set_mosaic_enabled(id_type id, bool mosaic_enabled);
@@ -163,6 +212,12 @@ namespace sprites_manager
 
     void set_remove_affine_mat_when_not_needed(id_type id, bool remove_when_not_needed);
 
+    #if BN_CFG_SPRITES_AFFINE_MATS_INTERNING_ENABLED
+        [[nodiscard]] bool interned_affine_mat_attributes(id_type id, affine_mat_attributes& attributes);
+
+        void set_interned_affine_mat(id_type id, const affine_mat_attributes& attributes);
+    #endif
+
     [[nodiscard]] sprite_first_attributes first_attributes(id_type id);
 
     void set_first_attributes(id_type id, const sprite_first_attributes& first_attributes);
@@ -201,7 +256,7 @@ namespace sprites_manager
     void fill_hblank_effect_third_attributes(
             sprite_shape_size shape_size, const sprite_third_attributes* third_attributes_ptr, uint16_t* dest_ptr);
 
-    void update_cameras();
+    void update_camera(int camera_id);
 
     void remove_identity_affine_mat_if_not_needed(id_type id);
 
@@ -209,16 +264,32 @@ namespace sprites_manager
 
     void update();
 
+    void prepare_commit();
+
     void commit();
 
     [[nodiscard]] BN_CODE_IWRAM bool _check_items_on_screen_impl(
-            void* hw_handles, intrusive_list<sorted_sprites::layer>& layers, bool rebuild_handles,
+            void* hw_handles, sprites_manager_hot_fields& hot_fields, bool rebuild_handles,
             int& first_index_to_commit, int& last_index_to_commit);
 
     [[nodiscard]] BN_CODE_IWRAM int _rebuild_handles_impl(
-            int last_visible_items_count, void* hw_handles, intrusive_list<sorted_sprites::layer>& layers);
+            int last_visible_items_count, void* hw_handles, sorted_sprites::layers_type& layers);
+
+    #if BN_CFG_SPRITES_SCANLINE_CYCLES_ENABLED
+        [[nodiscard]] BN_CODE_IWRAM int _update_scanline_cycles_impl(
+                const sorted_sprites::layers_type& layers, int16_t* scanline_cycles);
+
+        BN_CODE_IWRAM void _reverse_handles_impl(int visible_items_count, void* hw_handles,
+                                                 sorted_sprites::layers_type& layers);
+    #endif
+
+    #if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+        [[nodiscard]] BN_CODE_IWRAM int _rebuild_multiplexed_handles_impl(
+                int last_visible_items_count, void* hw_handles, sorted_sprites::layers_type& layers,
+                hw::sprites_multiplexing::bands& bands, int* band_items_counts, int& dropped_items_count);
+    #endif
 
-    [[nodiscard]] BN_CODE_IWRAM bool _update_cameras_impl(intrusive_list<sorted_sprites::layer>& layers);
+    [[nodiscard]] BN_CODE_IWRAM bool _update_camera_impl(int camera_id, sprites_manager_hot_fields& hot_fields);
 }
 
 }
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2020 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SPRITES_MANAGER_HOT_FIELDS_H
+#define BN_SPRITES_MANAGER_HOT_FIELDS_H
+
+#include "bn_config_cameras.h"
+#include "bn_sprites_manager_item.h"
+
+namespace bn
+{
+
+/*
+ * Packed copy of the sprite fields read by the culling and camera passes.
+ *
+ * Sprites attached to a camera are stored in a bitset per camera,
+ * so the camera pass only visits the sprites attached to the cameras which have been moved.
+ *
+ * Positions and dimensions are copied from the sprite item when it is marked to be checked,
+ * so the culling pass only touches the sprite item when its visibility in the screen changes
+ * or when its handle must be committed.
+ */
+class sprites_manager_hot_fields
+{
+
+public:
+    [[nodiscard]] constexpr static int words_count()
+    {
+        return (BN_CFG_SPRITES_MAX_ITEMS + 31) / 32;
+    }
+
+    sprites_manager_item* items[BN_CFG_SPRITES_MAX_ITEMS];
+    int16_t hw_xs[BN_CFG_SPRITES_MAX_ITEMS];
+    int16_t hw_ys[BN_CFG_SPRITES_MAX_ITEMS];
+    uint8_t widths[BN_CFG_SPRITES_MAX_ITEMS];
+    uint8_t heights[BN_CFG_SPRITES_MAX_ITEMS];
+    unsigned check_on_screen_bits[(BN_CFG_SPRITES_MAX_ITEMS + 31) / 32] = {};
+    unsigned on_screen_bits[(BN_CFG_SPRITES_MAX_ITEMS + 31) / 32] = {};
+    unsigned camera_bits[BN_CFG_CAMERA_MAX_ITEMS][(BN_CFG_SPRITES_MAX_ITEMS + 31) / 32] = {};
+    int8_t camera_ids[BN_CFG_SPRITES_MAX_ITEMS];
+
+    void add(sprites_manager_item& item)
+    {
+        int index = item.hot_index;
+        items[index] = &item;
+        _clear_bit(index, on_screen_bits);
+        camera_ids[index] = -1;
+        set_camera(item);
+
+        if(item.visible)
+        {
+            set_check_on_screen(item);
+        }
+        else
+        {
+            _clear_bit(index, check_on_screen_bits);
+        }
+    }
+
+    void remove(const sprites_manager_item& item)
+    {
+        int index = item.hot_index;
+        _clear_bit(index, check_on_screen_bits);
+        _clear_bit(index, on_screen_bits);
+        _remove_camera(index);
+    }
+
+    void set_check_on_screen(const sprites_manager_item& item)
+    {
+        int index = item.hot_index;
+        hw_xs[index] = int16_t(item.hw_position.x());
+        hw_ys[index] = int16_t(item.hw_position.y());
+        widths[index] = uint8_t(item.half_width * 2);
+        heights[index] = uint8_t(item.half_height * 2);
+        check_on_screen_bits[unsigned(index) / 32] |= 1u << (unsigned(index) % 32);
+    }
+
+    void hide(const sprites_manager_item& item)
+    {
+        int index = item.hot_index;
+        _clear_bit(index, check_on_screen_bits);
+        _clear_bit(index, on_screen_bits);
+    }
+
+    void set_camera(const sprites_manager_item& item)
+    {
+        int index = item.hot_index;
+        _remove_camera(index);
+
+        if(const optional<camera_ptr>& camera = item.camera)
+        {
+            int camera_id = camera->id();
+            camera_ids[index] = int8_t(camera_id);
+            camera_bits[camera_id][unsigned(index) / 32] |= 1u << (unsigned(index) % 32);
+        }
+    }
+
+private:
+    void _remove_camera(int index)
+    {
+        int camera_id = camera_ids[index];
+
+        if(camera_id >= 0)
+        {
+            camera_ids[index] = -1;
+            _clear_bit(index, camera_bits[camera_id]);
+        }
+    }
+
+    static void _clear_bit(int index, unsigned* bits)
+    {
+        bits[unsigned(index) / 32] &= ~(1u << (unsigned(index) % 32));
+    }
+};
+
+}
+
+#endif
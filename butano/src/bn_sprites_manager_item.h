@@ -51,6 +51,7 @@ public:
     optional<sprite_palette_ptr> palette;
     optional<sprite_affine_mat_ptr> affine_mat;
     optional<camera_ptr> camera;
+    int16_t hot_index = 0;
     int8_t handles_index = -1;
     int8_t half_width;
     int8_t half_height;
@@ -60,7 +61,7 @@ public:
     bool visible: 1;
     bool remove_affine_mat_when_not_needed: 1;
     bool on_screen: 1;
-    bool check_on_screen: 1;
+    bool multiplexing_dropped: 1;
 
     [[nodiscard]] static sprites_manager_item& affine_mat_attach_node_item(
             sprite_affine_mat_attach_node_type& attach_node)
@@ -84,7 +85,7 @@ public:
         visible(true),
         remove_affine_mat_when_not_needed(true),
         on_screen(false),
-        check_on_screen(true)
+        multiplexing_dropped(false)
     {
         const sprite_palette_ptr& palette_ref = *palette;
         hw::sprites::setup_regular(shape_size, tiles->id(), palette_ref.id(), palette_ref.bpp(),
@@ -105,7 +106,7 @@ public:
         visible(builder.visible()),
         remove_affine_mat_when_not_needed(builder.remove_affine_mat_when_not_needed()),
         on_screen(false),
-        check_on_screen(builder.visible())
+        multiplexing_dropped(false)
     {
         const sprite_palette_ptr& palette_ref = *palette;
 
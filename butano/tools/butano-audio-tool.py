@@ -7,6 +7,7 @@ import os
 import argparse
 import subprocess
 import sys
+import time
 import traceback
 
 from file_info import FileInfo
@@ -123,13 +124,23 @@ def write_output_files(audio_file_names_no_ext, soundbank_header_path, build_fol
                       build_folder_path + '/bn_sound_items.h')
 
 
+def elapsed_milliseconds(start):
+    return str(int((time.time() - start) * 1000))
+
+
 def process(audio_folder_paths, build_folder_path):
+    start = time.time()
     audio_file_names, audio_file_names_no_ext, audio_file_paths = list_audio_files(audio_folder_paths)
     file_info_path = build_folder_path + '/_bn_audio_files_info.txt'
     old_file_info = FileInfo.read(file_info_path)
     new_file_info = FileInfo.build_from_files(audio_file_paths)
 
+    list_milliseconds = elapsed_milliseconds(start)
+
+    # mmutil is not called if the content of the audio files has not changed:
     if old_file_info == new_file_info:
+        print('    Audio files not changed. Soundbank generation skipped')
+        print('    Audio files listed in ' + list_milliseconds + ' milliseconds')
         return
 
     for audio_file_name in audio_file_names:
@@ -137,11 +148,19 @@ def process(audio_folder_paths, build_folder_path):
 
     sys.stdout.flush()
 
+    start = time.time()
     soundbank_bin_path = build_folder_path + '/_bn_audio_soundbank.bin'
     soundbank_header_path = build_folder_path + '/_bn_audio_soundbank.h'
     total_size = process_audio_files(audio_file_paths, soundbank_bin_path, soundbank_header_path, build_folder_path)
+    mmutil_milliseconds = elapsed_milliseconds(start)
+
+    start = time.time()
     write_output_files(audio_file_names_no_ext, soundbank_header_path, build_folder_path)
+    write_milliseconds = elapsed_milliseconds(start)
     print('    Processed audio size: ' + str(total_size) + ' bytes')
+    print('    Audio files listed in ' + list_milliseconds + ' milliseconds')
+    print('    Soundbank generated in ' + mmutil_milliseconds + ' milliseconds')
+    print('    Audio items files written in ' + write_milliseconds + ' milliseconds')
     os.remove(soundbank_header_path)
     new_file_info.write(file_info_path)
 
@@ -3,8 +3,12 @@ Copyright (c) 2020 Gustavo Valiente gustavo.valiente@protonmail.com
 zlib License, see LICENSE file.
 """
 
+import io
 import os
 import json
+import contextlib
+import concurrent.futures
+import string
 import argparse
 import subprocess
 import sys
@@ -12,6 +16,7 @@ import time
 import traceback
 
 from bmp import BMP
+from compression import Compression
 from file_info import FileInfo
 
 
@@ -20,6 +25,110 @@ def remove_file(file_path):
         os.remove(file_path)
 
 
+def asm_values_line(asm_line, directive):
+    asm_words = asm_line.split(None, 1)
+
+    if len(asm_words) == 2 and asm_words[0] == directive:
+        return asm_words[1]
+
+    return None
+
+
+def asm_values_range(asm_lines, label, directive):
+    # grit writes a blank line after every 8 data lines,
+    # so values end at the first line which is neither a data line nor a blank one:
+    first_line_index = asm_lines.index(label + ':') + 1
+    last_line_index = first_line_index
+    line_index = first_line_index
+
+    while line_index < len(asm_lines):
+        asm_line = asm_lines[line_index]
+
+        if asm_values_line(asm_line, directive) is not None:
+            line_index += 1
+            last_line_index = line_index
+        elif len(asm_line.strip()) == 0:
+            line_index += 1
+        else:
+            break
+
+    return first_line_index, last_line_index
+
+
+def read_asm_values(asm_lines, label, directive):
+    first_line_index, last_line_index = asm_values_range(asm_lines, label, directive)
+    values = []
+
+    for asm_line in asm_lines[first_line_index:last_line_index]:
+        asm_values = asm_values_line(asm_line, directive)
+
+        if asm_values is not None:
+            for value in asm_values.split(','):
+                values.append(int(value, 16))
+
+    return values
+
+
+def write_asm_values(asm_lines, label, directive, values, values_per_line):
+    first_line_index, last_line_index = asm_values_range(asm_lines, label, directive)
+    values_lines = []
+
+    for value_index in range(0, len(values), values_per_line):
+        values_lines.append('\t' + directive + ' ' + ','.join(values[value_index:value_index + values_per_line]))
+
+    asm_lines[first_line_index:last_line_index] = values_lines
+
+
+def write_asm_binaries(asm_file_path):
+    # Data directives are replaced with .incbin ones, so the assembler doesn't have to parse them:
+    directive_sizes = {'.word': 4, '.hword': 2, '.byte': 1}
+    asm_folder_path = os.path.dirname(asm_file_path)
+
+    with open(asm_file_path, 'r') as asm_file:
+        asm_lines = asm_file.read().splitlines()
+
+    output_lines = []
+    line_index = 0
+
+    while line_index < len(asm_lines):
+        asm_line = asm_lines[line_index]
+        output_lines.append(asm_line)
+        line_index += 1
+
+        if asm_line.endswith(':') and not asm_line[0].isspace():
+            data = bytearray()
+
+            # grit writes a blank line after every 8 data lines, so they are skipped too:
+            while line_index < len(asm_lines):
+                asm_words = asm_lines[line_index].split(None, 1)
+
+                if len(asm_words) == 0:
+                    line_index += 1
+                    continue
+
+                if len(asm_words) != 2 or asm_words[0] not in directive_sizes:
+                    break
+
+                directive_size = directive_sizes[asm_words[0]]
+                directive_mask = (1 << (directive_size * 8)) - 1
+
+                for value in asm_words[1].split(','):
+                    data.extend((int(value, 0) & directive_mask).to_bytes(directive_size, 'little'))
+
+                line_index += 1
+
+            if len(data) > 0:
+                binary_file_name = asm_line[:-1] + '.bin'
+
+                with open(asm_folder_path + '/' + binary_file_name, 'wb') as binary_file:
+                    binary_file.write(data)
+
+                output_lines.append('\t.incbin "' + binary_file_name + '"')
+
+    with open(asm_file_path, 'w') as asm_file:
+        asm_file.write('\n'.join(output_lines) + '\n')
+
+
 class SpriteItem:
 
     @staticmethod
@@ -46,6 +155,20 @@ class SpriteItem:
         self.__graphics = int(bmp.height / height)
         width = bmp.width
 
+        try:
+            self.__compression = str(info['compression'])
+            Compression.validate(self.__compression)
+        except KeyError:
+            self.__compression = 'none'
+
+        try:
+            self.__delta_animation = bool(info['delta_animation'])
+        except KeyError:
+            self.__delta_animation = False
+
+        if self.__delta_animation and self.__graphics < 2:
+            raise ValueError('Delta animation requires two or more graphics: ' + str(self.__graphics))
+
         if width == 8:
             if height == 8:
                 self.__shape = 'SQUARE'
@@ -116,15 +239,26 @@ class SpriteItem:
 
         with open(grit_file_path, 'r') as grit_file:
             grit_data = grit_file.read()
-            grit_data = grit_data.replace('unsigned int', 'bn::tile')
-            grit_data = grit_data.replace(']', ' / (sizeof(bn::tile) / sizeof(uint32_t))]', 1)
-            grit_data = grit_data.replace('unsigned short', 'bn::color')
 
             for grit_line in grit_data.splitlines():
                 if 'Total size:' in grit_line:
                     total_size = int(grit_line.split()[-1])
                     break
 
+            if self.__delta_animation:
+                delta_declarations, delta_size = self.__write_deltas()
+                total_size += delta_size
+
+            if self.__compression != 'none':
+                grit_data, total_size = self.__compress_tiles(grit_data, total_size)
+
+            grit_data = grit_data.replace('unsigned int', 'bn::tile')
+            grit_data = grit_data.replace(']', ' / (sizeof(bn::tile) / sizeof(uint32_t))]', 1)
+            grit_data = grit_data.replace('unsigned short', 'bn::color')
+
+            if self.__delta_animation:
+                grit_data += delta_declarations
+
         remove_file(grit_file_path)
 
         if self.__bpp_8:
@@ -132,12 +266,21 @@ class SpriteItem:
         else:
             bpp_mode_label = 'bpp_mode::BPP_4'
 
+        if self.__compression == 'none':
+            compression_label = ''
+        else:
+            compression_label = Compression.labels[self.__compression] + ', '
+
         with open(header_file_path, 'w') as header_file:
             include_guard = 'BN_SPRITE_ITEMS_' + name.upper() + '_H'
             header_file.write('#ifndef ' + include_guard + '\n')
             header_file.write('#define ' + include_guard + '\n')
             header_file.write('\n')
             header_file.write('#include "bn_sprite_item.h"' + '\n')
+
+            if self.__delta_animation:
+                header_file.write('#include "bn_sprite_tiles_delta_item.h"' + '\n')
+
             header_file.write(grit_data)
             header_file.write('\n')
             header_file.write('namespace bn::sprite_items' + '\n')
@@ -147,9 +290,22 @@ class SpriteItem:
                               'sprite_size::' + self.__size + '), ' + '\n            ' +
                               'span<const tile>(' + name + '_bn_graphicsTiles), ' + '\n            ' +
                               'span<const color>(' + name + '_bn_graphicsPal, ' + str(self.__colors_count) + '), ' +
-                              bpp_mode_label + ', ' + str(self.__graphics) + ');' + '\n')
+                              bpp_mode_label + ', ' + compression_label + str(self.__graphics) + ');' + '\n')
             header_file.write('}' + '\n')
             header_file.write('\n')
+
+            if self.__delta_animation:
+                header_file.write('namespace bn::sprite_tiles_delta_items' + '\n')
+                header_file.write('{' + '\n')
+                header_file.write('    constexpr const sprite_tiles_delta_item ' + name + '(' +
+                                  'span<const tile>(' + name + '_bn_graphicsDeltaTiles), ' + '\n            ' +
+                                  'span<const uint8_t>(' + name + '_bn_graphicsDeltaTileIndexes), ' +
+                                  '\n            ' +
+                                  'span<const uint16_t>(' + name + '_bn_graphicsDeltaOffsets), ' +
+                                  bpp_mode_label + ', ' + str(self.__tiles_count_per_graphic) + ');' + '\n')
+                header_file.write('}' + '\n')
+                header_file.write('\n')
+
             header_file.write('#endif' + '\n')
             header_file.write('\n')
 
@@ -157,6 +313,174 @@ class SpriteItem:
         print('    sprite_item file written in ' + header_file_path)
         return total_size
 
+    def __read_tiles_data(self):
+        name = self.__file_name_no_ext
+        tiles_name = name + '_bn_graphicsTiles'
+        grit_asm_file_path = self.__build_folder_path + '/' + name + '_bn_graphics.s'
+
+        with open(grit_asm_file_path, 'r') as grit_asm_file:
+            grit_asm_lines = grit_asm_file.read().splitlines()
+
+        tiles_line_index, tiles_line_end = asm_values_range(grit_asm_lines, tiles_name, '.word')
+        tiles_data = bytearray()
+
+        for word in read_asm_values(grit_asm_lines, tiles_name, '.word'):
+            tiles_data.extend(word.to_bytes(4, 'little'))
+
+        return grit_asm_file_path, grit_asm_lines, tiles_line_index, tiles_line_end, tiles_data
+
+    def __write_deltas(self):
+        name = self.__file_name_no_ext
+        grit_asm_file_path, grit_asm_lines, tiles_line_index, tiles_line_end, tiles_data = self.__read_tiles_data()
+        tile_size = 32
+        graphics = self.__graphics
+        tiles_count = len(tiles_data) // (tile_size * graphics)
+
+        if tiles_count == 0 or tiles_count * tile_size * graphics != len(tiles_data):
+            raise ValueError('Invalid delta animation tiles size: ' + str(len(tiles_data)) + ' - ' + str(graphics))
+
+        self.__tiles_count_per_graphic = tiles_count
+
+        def graphic_tile(graphic_index, tile_index):
+            offset = ((graphic_index * tiles_count) + tile_index) * tile_size
+            return tiles_data[offset:offset + tile_size]
+
+        # Frames 0 and 1 are stored full, and the other ones as a delta of the frame displayed two frames before
+        # (frames 0 and 1 are stored again as a delta of the last two frames, so the animation can be looped):
+        delta_tiles = bytearray()
+        delta_tile_indexes = []
+        delta_offsets = []
+
+        for delta_index in range(graphics + 2):
+            graphic_index = delta_index % graphics
+            delta_offsets.append(len(delta_tile_indexes))
+
+            for tile_index in range(tiles_count):
+                tile_data = graphic_tile(graphic_index, tile_index)
+
+                if delta_index < 2 or tile_data != graphic_tile((delta_index - 2) % graphics, tile_index):
+                    delta_tiles.extend(tile_data)
+                    delta_tile_indexes.append(tile_index)
+
+        delta_offsets.append(len(delta_tile_indexes))
+
+        if len(delta_tile_indexes) > 65535:
+            raise ValueError('Too many delta animation tiles: ' + str(len(delta_tile_indexes)))
+
+        delta_tiles_count = len(delta_tile_indexes)
+        loop_tiles_count = delta_offsets[graphics + 2] - delta_offsets[2]
+        print('    Delta animation: ' + str(loop_tiles_count * tile_size) + ' bytes uploaded per loop (' +
+              str(tiles_count * graphics * tile_size) + ' bytes without deltas)')
+
+        delta_lines = ['', '\t.section .rodata', '\t.align\t2']
+        labels = [name + '_bn_graphicsDeltaTiles', name + '_bn_graphicsDeltaTileIndexes',
+                  name + '_bn_graphicsDeltaOffsets']
+        delta_lines.append('\t.global ' + labels[0] + '\t\t@ ' + str(len(delta_tiles)) + ' unsigned chars')
+        delta_lines.append('\t.hidden ' + labels[0])
+        delta_lines.append(labels[0] + ':')
+
+        for line_index in range(0, len(delta_tiles), tile_size):
+            words = []
+
+            for index in range(line_index, line_index + tile_size, 4):
+                words.append('0x%08X' % int.from_bytes(delta_tiles[index:index + 4], 'little'))
+
+            delta_lines.append('\t.word ' + ','.join(words))
+
+        delta_lines.append('')
+        delta_lines.append('\t.global ' + labels[1] + '\t\t@ ' + str(delta_tiles_count) + ' unsigned chars')
+        delta_lines.append('\t.hidden ' + labels[1])
+        delta_lines.append(labels[1] + ':')
+
+        for line_index in range(0, delta_tiles_count, 16):
+            values = delta_tile_indexes[line_index:line_index + 16]
+            delta_lines.append('\t.byte ' + ','.join('0x%02X' % value for value in values))
+
+        delta_lines.append('')
+        delta_lines.append('\t.align\t2')
+        delta_lines.append('\t.global ' + labels[2] + '\t\t@ ' + str(len(delta_offsets) * 2) + ' unsigned chars')
+        delta_lines.append('\t.hidden ' + labels[2])
+        delta_lines.append(labels[2] + ':')
+
+        for line_index in range(0, len(delta_offsets), 8):
+            values = delta_offsets[line_index:line_index + 8]
+            delta_lines.append('\t.hword ' + ','.join('0x%04X' % value for value in values))
+
+        with open(grit_asm_file_path, 'w') as grit_asm_file:
+            grit_asm_file.write('\n'.join(grit_asm_lines + delta_lines) + '\n')
+
+        delta_declarations = '\n'
+        delta_declarations += 'extern const bn::tile ' + labels[0] + '[' + str(delta_tiles_count) + '];\n'
+        delta_declarations += 'extern const uint8_t ' + labels[1] + '[' + str(delta_tiles_count) + '];\n'
+        delta_declarations += 'extern const uint16_t ' + labels[2] + '[' + str(len(delta_offsets)) + '];\n'
+        delta_size = len(delta_tiles) + delta_tiles_count + (len(delta_offsets) * 2)
+        return delta_declarations, delta_size
+
+    def __compress_tiles(self, grit_data, total_size):
+        name = self.__file_name_no_ext
+        tiles_name = name + '_bn_graphicsTiles'
+        grit_asm_file_path, grit_asm_lines, tiles_line_index, tiles_line_end, tiles_data = self.__read_tiles_data()
+        graphic_size = len(tiles_data) // self.__graphics
+
+        if self.__compression == 'auto':
+            compressions = ['lz77', 'run_length', 'huffman']
+        else:
+            compressions = [self.__compression]
+
+        best_compression = None
+
+        for compression in compressions:
+            blocks = []
+
+            for graphic_index in range(self.__graphics):
+                graphic_data = tiles_data[graphic_index * graphic_size:(graphic_index + 1) * graphic_size]
+                blocks.append(Compression.compress(compression, graphic_data))
+
+            # All blocks are padded to the same size, which must be a multiple of the tile size (32 bytes):
+            block_size = max(len(block) for block in blocks)
+            block_size = ((block_size + 31) // 32) * 32
+            compressed_size = block_size * self.__graphics
+            print('    Tiles compression (' + compression + '): ' + str(len(tiles_data)) + ' bytes -> ' +
+                  str(compressed_size) + ' bytes (' + str(int((compressed_size * 100) / len(tiles_data))) + '%)')
+
+            if best_compression is None or block_size < best_block_size:
+                best_compression = compression
+                best_blocks = blocks
+                best_block_size = block_size
+
+        if best_block_size >= graphic_size:
+            print('    Tiles compression discarded: compressed tiles are not smaller than uncompressed ones')
+            self.__compression = 'none'
+            return grit_data, total_size
+
+        self.__compression = best_compression
+        compressed_data = bytearray()
+
+        for block in best_blocks:
+            compressed_data.extend(block)
+            compressed_data.extend(bytearray(best_block_size - len(block)))
+
+        compressed_lines = []
+
+        for line_index in range(0, len(compressed_data), 32):
+            words = []
+
+            for index in range(line_index, line_index + 32, 4):
+                words.append('0x%08X' % int.from_bytes(compressed_data[index:index + 4], 'little'))
+
+            compressed_lines.append('\t.word ' + ','.join(words))
+
+        grit_asm_lines[tiles_line_index:tiles_line_end] = compressed_lines
+
+        with open(grit_asm_file_path, 'w') as grit_asm_file:
+            grit_asm_file.write('\n'.join(grit_asm_lines) + '\n')
+
+        grit_data = grit_data.replace(tiles_name + 'Len ' + str(len(tiles_data)),
+                                      tiles_name + 'Len ' + str(len(compressed_data)))
+        grit_data = grit_data.replace(tiles_name + '[' + str(len(tiles_data) // 4) + ']',
+                                      tiles_name + '[' + str(len(compressed_data) // 4) + ']')
+        return grit_data, total_size - len(tiles_data) + len(compressed_data)
+
     def process(self):
         command = ['grit', self.__file_path, '-gt']
 
@@ -273,6 +597,43 @@ class RegularBgItem:
         except KeyError:
             self.__flipped_tiles_reduction = True
 
+        try:
+            self.__tiles_group = str(info['tiles_group'])
+            RegularBgTilesGroup.validate_name(self.__tiles_group)
+
+            if not self.__repeated_tiles_reduction:
+                raise ValueError('Regular BGs with tiles group require repeated tiles reduction')
+        except KeyError:
+            self.__tiles_group = None
+
+        self.__tiles_group_saved_size = 0
+
+        try:
+            self.__column_major_map = bool(info['column_major_map'])
+        except KeyError:
+            self.__column_major_map = False
+
+        if self.__column_major_map and self.__width in (32, 64) and self.__height in (32, 64):
+            raise ValueError('Column-major maps are only supported by big regular BGs: ' +
+                             str(width) + ' - ' + str(height))
+
+        try:
+            metatile_size = int(info['metatile_size'])
+
+            if metatile_size != 16 and metatile_size != 32:
+                raise ValueError('Invalid metatile size: ' + str(metatile_size))
+
+            if self.__width in (32, 64) and self.__height in (32, 64):
+                raise ValueError('Metatiles are only supported by big regular BGs: ' +
+                                 str(width) + ' - ' + str(height))
+
+            if self.__column_major_map:
+                raise ValueError('Regular BGs with metatiles don\'t support column-major maps')
+
+            self.__metatile_size = metatile_size // 8
+        except KeyError:
+            self.__metatile_size = None
+
         if self.__colors_count > 16:
             try:
                 bpp_mode = str(info['bpp_mode'])
@@ -293,18 +654,54 @@ class RegularBgItem:
             elif bpp_mode != 'bpp_4_manual':
                 raise ValueError('Invalid BPP mode: ' + bpp_mode)
 
+    def file_name_no_ext(self):
+        return self.__file_name_no_ext
+
+    def tiles_group(self):
+        return self.__tiles_group
+
+    def bpp_8(self):
+        return self.__bpp_8
+
+    def flipped_tiles_reduction(self):
+        return self.__flipped_tiles_reduction
+
+    def tiles_group_saved_size(self):
+        return self.__tiles_group_saved_size
+
+    def set_tiles_group_saved_size(self, saved_size):
+        self.__tiles_group_saved_size = saved_size
+
     def write_header(self):
         name = self.__file_name_no_ext
+        tiles_group = self.__tiles_group
         grit_file_path = self.__build_folder_path + '/' + name + '_bn_graphics.h'
         header_file_path = self.__build_folder_path + '/bn_regular_bg_items_' + name + '.h'
 
         with open(grit_file_path, 'r') as grit_file:
             grit_data = grit_file.read()
-            grit_data = grit_data.replace('unsigned int', 'bn::tile', 1)
-            grit_data = grit_data.replace(']', ' / (sizeof(bn::tile) / sizeof(uint32_t))]', 1)
+
+            if tiles_group is None:
+                grit_data = grit_data.replace('unsigned int', 'bn::tile', 1)
+                grit_data = grit_data.replace(']', ' / (sizeof(bn::tile) / sizeof(uint32_t))]', 1)
+            else:
+                # Tiles are stored in the tiles group, so they are not declared here:
+                tiles_name = name + '_bn_graphicsTiles'
+                grit_data = '\n'.join(grit_line for grit_line in grit_data.splitlines()
+                                      if tiles_name not in grit_line) + '\n'
+
             grit_data = grit_data.replace('unsigned short', 'bn::regular_bg_map_cell', 1)
             grit_data = grit_data.replace('unsigned short', 'bn::color', 1)
 
+            if self.__metatile_size is not None:
+                # Map cells are replaced with metatile indexes:
+                map_cells_count = self.__width * self.__height
+                metatile_indexes_count = map_cells_count // (self.__metatile_size * self.__metatile_size)
+                grit_data = grit_data.replace(name + '_bn_graphicsMapLen ' + str(map_cells_count * 2),
+                                              name + '_bn_graphicsMapLen ' + str(metatile_indexes_count * 2), 1)
+                grit_data = grit_data.replace(name + '_bn_graphicsMap[' + str(map_cells_count) + ']',
+                                              name + '_bn_graphicsMap[' + str(metatile_indexes_count) + ']', 1)
+
             for grit_line in grit_data.splitlines():
                 if ' tiles ' in grit_line:
                     for grit_word in grit_line.split():
@@ -334,25 +731,155 @@ class RegularBgItem:
             header_file.write('#define ' + include_guard + '\n')
             header_file.write('\n')
             header_file.write('#include "bn_regular_bg_item.h"' + '\n')
+
+            if tiles_group is not None:
+                header_file.write('#include "bn_regular_bg_tiles_items_' + tiles_group + '.h"' + '\n')
+
             header_file.write(grit_data)
+
+            if self.__column_major_map:
+                column_map_size = self.__write_column_major_map()
+                total_size += column_map_size
+                header_file.write('extern const bn::regular_bg_map_cell ' + name + '_bn_graphicsColumnMap[' +
+                                  str(column_map_size // 2) + '];' + '\n')
+
+            if self.__metatile_size is not None:
+                metatiles_cells_count = self.__write_metatiles_map()
+                metatile_size = self.__metatile_size
+                metatiles_count = metatiles_cells_count // (metatile_size * metatile_size)
+                map_cells_count = self.__width * self.__height
+                metatiles_size = (metatiles_cells_count + (map_cells_count // (metatile_size * metatile_size))) * 2
+                total_size += metatiles_size - (map_cells_count * 2)
+                print('    Metatiles: ' + str(metatiles_count) + ' (map size: ' + str(map_cells_count * 2) + ' -> ' +
+                      str(metatiles_size) + ' bytes)')
+                header_file.write('extern const bn::regular_bg_map_cell ' + name + '_bn_graphicsMetatiles[' +
+                                  str(metatiles_cells_count) + '];' + '\n')
+
             header_file.write('\n')
             header_file.write('namespace bn::regular_bg_items' + '\n')
             header_file.write('{' + '\n')
-            header_file.write('    constexpr const regular_bg_item ' + name + '(' +
-                              'span<const tile>(' + name + '_bn_graphicsTiles), ' + '\n            ' +
-                              'span<const color>(' + name + '_bn_graphicsPal, ' + str(self.__colors_count) + '), ' +
-                              bpp_mode_label + ', ' + '\n            ' +
-                              name + '_bn_graphicsMap[0], ' +
-                              'size(' + str(self.__width) + ', ' + str(self.__height) + '));' + '\n')
+
+            if tiles_group is None:
+                tiles_item = 'regular_bg_tiles_item(span<const tile>(' + name + '_bn_graphicsTiles), ' + \
+                             bpp_mode_label + ')'
+            else:
+                tiles_item = 'regular_bg_tiles_items::' + tiles_group
+
+            if self.__column_major_map:
+                column_map_arg = name + '_bn_graphicsColumnMap[0], '
+            elif self.__metatile_size is not None:
+                column_map_arg = name + '_bn_graphicsMetatiles[0], ' + str(self.__metatile_size) + ', '
+            else:
+                column_map_arg = ''
+
+            if tiles_group is None and not column_map_arg:
+                header_file.write('    constexpr const regular_bg_item ' + name + '(' +
+                                  'span<const tile>(' + name + '_bn_graphicsTiles), ' + '\n            ' +
+                                  'span<const color>(' + name + '_bn_graphicsPal, ' + str(self.__colors_count) +
+                                  '), ' + bpp_mode_label + ', ' + '\n            ' +
+                                  name + '_bn_graphicsMap[0], ' +
+                                  'size(' + str(self.__width) + ', ' + str(self.__height) + '));' + '\n')
+            else:
+                header_file.write('    constexpr const regular_bg_item ' + name + '(' +
+                                  tiles_item + ', ' + '\n            ' +
+                                  'bg_palette_item(span<const color>(' + name + '_bn_graphicsPal, ' +
+                                  str(self.__colors_count) + '), ' + bpp_mode_label + '), ' + '\n            ' +
+                                  'regular_bg_map_item(' + name + '_bn_graphicsMap[0], ' + column_map_arg +
+                                  'size(' + str(self.__width) + ', ' + str(self.__height) + ')));' + '\n')
+
             header_file.write('}' + '\n')
             header_file.write('\n')
             header_file.write('#endif' + '\n')
             header_file.write('\n')
 
+        if tiles_group is not None:
+            saved_size = self.__tiles_group_saved_size
+            total_size -= saved_size
+            print('    Tiles group (' + tiles_group + '): ' + str(saved_size) + ' bytes saved')
+
         print('    Graphics size: ' + str(total_size) + ' bytes')
         print('    regular_bg_item file written in ' + header_file_path)
         return total_size
 
+    def __write_column_major_map(self):
+        name = self.__file_name_no_ext
+        grit_asm_file_path = self.__build_folder_path + '/' + name + '_bn_graphics.s'
+        column_map_name = name + '_bn_graphicsColumnMap'
+
+        with open(grit_asm_file_path, 'r') as grit_asm_file:
+            grit_asm_lines = grit_asm_file.read().splitlines()
+
+        # Map cells are stored column by column, so big maps columns can be read in one go:
+        map_cells = read_asm_values(grit_asm_lines, name + '_bn_graphicsMap', '.hword')
+        width = self.__width
+        height = self.__height
+        column_map_cells = [map_cells[(y * width) + x] for x in range(width) for y in range(height)]
+        column_map_lines = ['', '\t.section .rodata', '\t.align\t2',
+                            '\t.global ' + column_map_name + '\t\t@ ' + str(len(column_map_cells) * 2) +
+                            ' unsigned chars', '\t.hidden ' + column_map_name, column_map_name + ':']
+
+        for cell_index in range(0, len(column_map_cells), 8):
+            values = column_map_cells[cell_index:cell_index + 8]
+            column_map_lines.append('\t.hword ' + ','.join('0x%04X' % value for value in values))
+
+        with open(grit_asm_file_path, 'w') as grit_asm_file:
+            grit_asm_file.write('\n'.join(grit_asm_lines + column_map_lines) + '\n')
+
+        return len(column_map_cells) * 2
+
+    def __write_metatiles_map(self):
+        name = self.__file_name_no_ext
+        grit_asm_file_path = self.__build_folder_path + '/' + name + '_bn_graphics.s'
+        map_name = name + '_bn_graphicsMap'
+        metatiles_name = name + '_bn_graphicsMetatiles'
+
+        with open(grit_asm_file_path, 'r') as grit_asm_file:
+            grit_asm_lines = grit_asm_file.read().splitlines()
+
+        # Map cells are split in square blocks, and equal blocks are stored only once:
+        map_cells = read_asm_values(grit_asm_lines, map_name, '.hword')
+        width = self.__width
+        metatile_size = self.__metatile_size
+        metatiles = {}
+        metatile_indexes = []
+        metatiles_cells = []
+
+        for metatile_y in range(0, self.__height, metatile_size):
+            for metatile_x in range(0, width, metatile_size):
+                metatile = tuple(map_cells[((metatile_y + y) * width) + metatile_x + x]
+                                 for y in range(metatile_size) for x in range(metatile_size))
+                metatile_index = metatiles.get(metatile)
+
+                if metatile_index is None:
+                    metatile_index = len(metatiles)
+                    metatiles[metatile] = metatile_index
+                    metatiles_cells.extend(metatile)
+
+                metatile_indexes.append(metatile_index)
+
+        if len(metatiles) > 65536:
+            raise ValueError('Regular BGs with more than 65536 metatiles not supported: ' + str(len(metatiles)))
+
+        write_asm_values(grit_asm_lines, map_name, '.hword', ['0x%04X' % value for value in metatile_indexes], 8)
+
+        for grit_asm_line_index, grit_asm_line in enumerate(grit_asm_lines):
+            if grit_asm_line.startswith('\t.global ' + map_name + '\t'):
+                grit_asm_lines[grit_asm_line_index] = '\t.global ' + map_name + '\t\t@ ' + \
+                                                      str(len(metatile_indexes) * 2) + ' unsigned chars'
+
+        metatiles_lines = ['', '\t.section .rodata', '\t.align\t2',
+                           '\t.global ' + metatiles_name + '\t\t@ ' + str(len(metatiles_cells) * 2) +
+                           ' unsigned chars', '\t.hidden ' + metatiles_name, metatiles_name + ':']
+
+        for cell_index in range(0, len(metatiles_cells), 8):
+            values = metatiles_cells[cell_index:cell_index + 8]
+            metatiles_lines.append('\t.hword ' + ','.join('0x%04X' % value for value in values))
+
+        with open(grit_asm_file_path, 'w') as grit_asm_file:
+            grit_asm_file.write('\n'.join(grit_asm_lines + metatiles_lines) + '\n')
+
+        return len(metatiles_cells)
+
     def process(self):
         command = ['grit', self.__file_path]
 
@@ -393,6 +920,201 @@ class RegularBgItem:
             raise ValueError('grit call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
 
 
+class RegularBgTilesGroup:
+
+    @staticmethod
+    def validate_name(name):
+        if len(name) == 0 or name[0] not in string.ascii_lowercase:
+            raise ValueError('Invalid tiles group name: ' + name)
+
+        valid_characters = '_%s%s' % (string.ascii_lowercase, string.digits)
+
+        for name_character in name:
+            if name_character not in valid_characters:
+                raise ValueError('Invalid tiles group name: ' + name + ' (invalid character: \'' +
+                                 name_character + '\')')
+
+    @staticmethod
+    def file_info_path(name, build_folder_path):
+        return build_folder_path + '/_bn_' + name + '_regular_bg_tiles_group_file_info.txt'
+
+    @staticmethod
+    def build_file_info(item_names):
+        return FileInfo('\n'.join(sorted(item_names)), False)
+
+    def __init__(self, name, build_folder_path, items):
+        self.__name = name
+        self.__build_folder_path = build_folder_path
+        self.__items = sorted(items, key=lambda item: item.file_name_no_ext())
+
+    def process(self):
+        name = self.__name
+        items = self.__items
+        bpp_8 = items[0].bpp_8()
+
+        for item in items:
+            if item.bpp_8() != bpp_8:
+                raise ValueError('Regular BGs with different BPP mode in the same tiles group (' + name + '): ' +
+                                 items[0].file_name_no_ext() + ' - ' + item.file_name_no_ext())
+
+        if bpp_8:
+            tile_size = 64
+        else:
+            tile_size = 32
+
+        tiles_data = bytearray()
+        tiles_map = {}
+        grit_tiles_count = 0
+
+        for item in items:
+            item_name = item.file_name_no_ext()
+            grit_asm_file_path = self.__build_folder_path + '/' + item_name + '_bn_graphics.s'
+
+            with open(grit_asm_file_path, 'r') as grit_asm_file:
+                grit_asm_lines = grit_asm_file.read().splitlines()
+
+            item_tiles_data = bytearray()
+
+            for value in read_asm_values(grit_asm_lines, item_name + '_bn_graphicsTiles', '.word'):
+                item_tiles_data.extend(value.to_bytes(4, 'little'))
+
+            map_cells = read_asm_values(grit_asm_lines, item_name + '_bn_graphicsMap', '.hword')
+            item_tiles_count = len(item_tiles_data) // tile_size
+            grit_tiles_count += item_tiles_count
+            new_tiles_count = 0
+            new_map_cells = []
+
+            # Map cells are remapped to the tiles group, using the flip bits to reuse flipped tiles too:
+            for map_cell in map_cells:
+                tile_index = map_cell & 1023
+                tile_offset = tile_index * tile_size
+                tile_data = RegularBgTilesGroup.__flip_tile(item_tiles_data[tile_offset:tile_offset + tile_size],
+                                                            (map_cell >> 10) & 3, bpp_8)
+
+                if item.flipped_tiles_reduction():
+                    flips_list = range(4)
+                else:
+                    flips_list = range(1)
+
+                for flips in flips_list:
+                    group_tile_index = tiles_map.get(RegularBgTilesGroup.__flip_tile(tile_data, flips, bpp_8))
+
+                    if group_tile_index is not None:
+                        break
+
+                if group_tile_index is None:
+                    flips = 0
+                    group_tile_index = len(tiles_map)
+                    tiles_map[bytes(tile_data)] = group_tile_index
+                    tiles_data.extend(tile_data)
+                    new_tiles_count += 1
+
+                new_map_cells.append((map_cell & 0xF000) | (flips << 10) | group_tile_index)
+
+            write_asm_values(grit_asm_lines, item_name + '_bn_graphicsMap', '.hword',
+                             ['0x%04X' % map_cell for map_cell in new_map_cells], 8)
+            RegularBgTilesGroup.__remove_block(grit_asm_lines, item_name + '_bn_graphicsTiles')
+
+            with open(grit_asm_file_path, 'w') as grit_asm_file:
+                grit_asm_file.write('\n'.join(grit_asm_lines) + '\n')
+
+            item.set_tiles_group_saved_size((item_tiles_count - new_tiles_count) * tile_size)
+
+        tiles_count = len(tiles_map)
+
+        if tiles_count > 1024:
+            raise ValueError('Regular BG tiles groups with more than 1024 tiles not supported: ' + str(tiles_count))
+
+        # Tiles group data is stored in the first regular BG assembly file:
+        self.__write_tiles(items[0], tiles_data, tile_size)
+        self.__write_header(tiles_data, bpp_8)
+        RegularBgTilesGroup.build_file_info([item.file_name_no_ext() for item in items]).write(
+            RegularBgTilesGroup.file_info_path(name, self.__build_folder_path))
+
+        print('    Tiles group (' + name + '): ' + str(tiles_count) + ' tiles (' + str(grit_tiles_count) +
+              ' tiles without tiles group)')
+
+    def __write_tiles(self, item, tiles_data, tile_size):
+        tiles_name = self.__name + '_bn_tiles_groupTiles'
+        grit_asm_file_path = self.__build_folder_path + '/' + item.file_name_no_ext() + '_bn_graphics.s'
+        tiles_lines = ['', '\t.section .rodata', '\t.align\t2',
+                       '\t.global ' + tiles_name + '\t\t@ ' + str(len(tiles_data)) + ' unsigned chars',
+                       '\t.hidden ' + tiles_name, tiles_name + ':']
+
+        for line_index in range(0, len(tiles_data), 32):
+            words = []
+
+            for index in range(line_index, line_index + 32, 4):
+                words.append('0x%08X' % int.from_bytes(tiles_data[index:index + 4], 'little'))
+
+            tiles_lines.append('\t.word ' + ','.join(words))
+
+        with open(grit_asm_file_path, 'a') as grit_asm_file:
+            grit_asm_file.write('\n'.join(tiles_lines) + '\n')
+
+    def __write_header(self, tiles_data, bpp_8):
+        name = self.__name
+        header_file_path = self.__build_folder_path + '/bn_regular_bg_tiles_items_' + name + '.h'
+
+        if bpp_8:
+            bpp_mode_label = 'bpp_mode::BPP_8'
+        else:
+            bpp_mode_label = 'bpp_mode::BPP_4'
+
+        with open(header_file_path, 'w') as header_file:
+            include_guard = 'BN_REGULAR_BG_TILES_ITEMS_' + name.upper() + '_H'
+            header_file.write('#ifndef ' + include_guard + '\n')
+            header_file.write('#define ' + include_guard + '\n')
+            header_file.write('\n')
+            header_file.write('#include "bn_regular_bg_tiles_item.h"' + '\n')
+            header_file.write('\n')
+            header_file.write('extern const bn::tile ' + name + '_bn_tiles_groupTiles[' +
+                              str(len(tiles_data) // 32) + '];' + '\n')
+            header_file.write('\n')
+            header_file.write('namespace bn::regular_bg_tiles_items' + '\n')
+            header_file.write('{' + '\n')
+            header_file.write('    constexpr const regular_bg_tiles_item ' + name + '(' +
+                              'span<const tile>(' + name + '_bn_tiles_groupTiles), ' + bpp_mode_label + ');' + '\n')
+            header_file.write('}' + '\n')
+            header_file.write('\n')
+            header_file.write('#endif' + '\n')
+            header_file.write('\n')
+
+        print('    regular_bg_tiles_item file written in ' + header_file_path)
+
+    @staticmethod
+    def __flip_tile(tile_data, flips, bpp_8):
+        row_size = len(tile_data) // 8
+        rows = [tile_data[index:index + row_size] for index in range(0, len(tile_data), row_size)]
+
+        if flips & 1:
+            if bpp_8:
+                rows = [row[::-1] for row in rows]
+            else:
+                rows = [bytes(((value & 15) << 4) | (value >> 4) for value in row[::-1]) for row in rows]
+
+        if flips & 2:
+            rows = rows[::-1]
+
+        return b''.join(bytes(row) for row in rows)
+
+    @staticmethod
+    def __remove_block(grit_asm_lines, label):
+        first_line_index, last_line_index = asm_values_range(grit_asm_lines, label, '.word')
+
+        # Section, alignment and symbol directives are removed too:
+        while first_line_index > 0 and not grit_asm_lines[first_line_index - 1].strip().startswith('.section'):
+            first_line_index -= 1
+
+        if first_line_index > 0:
+            first_line_index -= 1
+
+        if last_line_index < len(grit_asm_lines) and len(grit_asm_lines[last_line_index].strip()) == 0:
+            last_line_index += 1
+
+        del grit_asm_lines[first_line_index:last_line_index]
+
+
 class AffineBgItem:
 
     def __init__(self, file_path, file_name_no_ext, build_folder_path, info):
@@ -558,7 +1280,7 @@ class BgPaletteItem:
 class GraphicsFileInfo:
 
     def __init__(self, graphics_type, info, file_path, file_name, file_name_no_ext, new_file_info,
-                 file_info_path, new_json_file_info, json_file_info_path):
+                 file_info_path, new_json_file_info, json_file_info_path, binaries):
         self.__graphics_type = graphics_type
         self.__info = info
         self.__file_path = file_path
@@ -568,6 +1290,7 @@ class GraphicsFileInfo:
         self.__file_info_path = file_info_path
         self.__new_json_file_info = new_json_file_info
         self.__json_file_info_path = json_file_info_path
+        self.__binaries = binaries
 
     def process(self, build_folder_path):
         print(self.__file_name)
@@ -587,13 +1310,29 @@ class GraphicsFileInfo:
             raise ValueError('Unknown graphics type: ' + str(self.__graphics_type))
 
         item.process()
-        file_size = item.write_header()
+        self.__item = item
+
+        if self.__graphics_type == 'regular_bg' and item.tiles_group() is not None:
+            # Header is written after the tiles group is processed:
+            return None
+
+        return self.write_header(build_folder_path)
+
+    def item(self):
+        return self.__item
+
+    def write_header(self, build_folder_path):
+        file_size = self.__item.write_header()
+
+        if self.__binaries:
+            write_asm_binaries(build_folder_path + '/' + self.__file_name_no_ext + '_bn_graphics.s')
+
         self.__new_file_info.write(self.__file_info_path)
         self.__new_json_file_info.write(self.__json_file_info_path)
         return file_size
 
 
-def list_graphics_file_infos(graphics_folder_paths, build_folder_path):
+def list_graphics_file_infos(graphics_folder_paths, build_folder_path, binaries):
     graphics_folder_path_list = graphics_folder_paths.split(' ')
     graphics_file_infos = []
     sprite_file_names_set = set()
@@ -601,6 +1340,7 @@ def list_graphics_file_infos(graphics_folder_paths, build_folder_path):
     regular_bg_file_names_set = set()
     affine_bg_file_names_set = set()
     bg_palette_file_names_set = set()
+    tiles_groups = {}
 
     for graphics_folder_path in graphics_folder_path_list:
         graphics_file_names = sorted(os.listdir(graphics_folder_path))
@@ -658,34 +1398,133 @@ def list_graphics_file_infos(graphics_folder_paths, build_folder_path):
                     old_json_file_info = FileInfo.read(json_file_info_path)
                     new_json_file_info = FileInfo.build_from_file(json_file_path)
 
-                    if old_file_info != new_file_info or old_json_file_info != new_json_file_info:
-                        graphics_file_infos.append(GraphicsFileInfo(
-                            graphics_type, info, graphics_file_path, graphics_file_name, graphics_file_name_no_ext,
-                            new_file_info, file_info_path, new_json_file_info, json_file_info_path))
+                    graphics_file_info = GraphicsFileInfo(
+                        graphics_type, info, graphics_file_path, graphics_file_name, graphics_file_name_no_ext,
+                        new_file_info, file_info_path, new_json_file_info, json_file_info_path, binaries)
+                    updated = old_file_info != new_file_info or old_json_file_info != new_json_file_info
+
+                    if graphics_type == 'regular_bg' and 'tiles_group' in info:
+                        tiles_group = str(info['tiles_group'])
+                        tiles_groups.setdefault(tiles_group, []).append(
+                            (graphics_file_name_no_ext, graphics_file_info, updated))
+                    elif updated:
+                        graphics_file_infos.append(graphics_file_info)
+
+    # If a regular BG of a tiles group is updated, all of them must be processed again:
+    for tiles_group, tiles_group_infos in tiles_groups.items():
+        old_file_info = FileInfo.read(RegularBgTilesGroup.file_info_path(tiles_group, build_folder_path))
+        new_file_info = RegularBgTilesGroup.build_file_info([name for name, _, _ in tiles_group_infos])
+
+        if old_file_info != new_file_info or any(updated for _, _, updated in tiles_group_infos):
+            graphics_file_infos.extend(graphics_file_info for _, graphics_file_info, _ in tiles_group_infos)
 
     return graphics_file_infos
 
 
-def process(graphics_folder_paths, build_folder_path):
-    graphics_file_infos = list_graphics_file_infos(graphics_folder_paths, build_folder_path)
+def process_graphics_file_info(graphics_file_info, build_folder_path):
+    # Output is captured, so it is not mixed with the output of other workers:
+    output = io.StringIO()
+
+    with contextlib.redirect_stdout(output):
+        try:
+            file_size = graphics_file_info.process(build_folder_path)
+        except Exception as exception:
+            # The traceback is returned too, since it is lost when the exception is sent to the main process:
+            return graphics_file_info, None, output.getvalue(), (str(exception), traceback.format_exc())
+
+    return graphics_file_info, file_size, output.getvalue(), None
+
+
+def process_graphics_file_infos(graphics_file_infos, build_folder_path, jobs):
+    if jobs <= 1 or len(graphics_file_infos) <= 1:
+        return [process_graphics_file_info(graphics_file_info, build_folder_path)
+                for graphics_file_info in graphics_file_infos]
+
+    with concurrent.futures.ProcessPoolExecutor(max_workers=min(jobs, len(graphics_file_infos))) as executor:
+        futures = [executor.submit(process_graphics_file_info, graphics_file_info, build_folder_path)
+                   for graphics_file_info in graphics_file_infos]
+        return [future.result() for future in futures]
+
+
+def elapsed_milliseconds(start):
+    return str(int((time.time() - start) * 1000))
+
+
+def process(graphics_folder_paths, build_folder_path, jobs, binaries):
+    start = time.time()
+    graphics_file_infos = list_graphics_file_infos(graphics_folder_paths, build_folder_path, binaries)
 
     if len(graphics_file_infos) > 0:
+        list_milliseconds = elapsed_milliseconds(start)
+        start = time.time()
+        results = process_graphics_file_infos(graphics_file_infos, build_folder_path, jobs)
+        process_milliseconds = elapsed_milliseconds(start)
         total_size = 0
+        tiles_groups = {}
+
+        for graphics_file_info, file_size, output, error in results:
+            sys.stdout.write(output)
+            sys.stdout.flush()
+
+            if error is not None:
+                error_message, error_traceback = error
+                sys.stderr.write(error_traceback)
+                raise ValueError(error_message)
+
+            if file_size is None:
+                tiles_groups.setdefault(graphics_file_info.item().tiles_group(), []).append(graphics_file_info)
+            else:
+                total_size += file_size
+
+        start = time.time()
+        saved_sizes = []
+
+        for tiles_group, tiles_group_infos in sorted(tiles_groups.items()):
+            print('Tiles group ' + tiles_group)
+            sys.stdout.flush()
+
+            items = [graphics_file_info.item() for graphics_file_info in tiles_group_infos]
+            RegularBgTilesGroup(tiles_group, build_folder_path, items).process()
 
-        for graphics_file_info in graphics_file_infos:
-            total_size += graphics_file_info.process(build_folder_path)
+            for graphics_file_info in tiles_group_infos:
+                print(graphics_file_info.item().file_name_no_ext())
+                total_size += graphics_file_info.write_header(build_folder_path)
+                item = graphics_file_info.item()
+                saved_sizes.append((item.file_name_no_ext(), item.tiles_group_saved_size()))
 
+        tiles_groups_milliseconds = elapsed_milliseconds(start)
         print('    ' + 'Processed graphics size: ' + str(total_size) + ' bytes')
 
+        if len(saved_sizes) > 0:
+            print('    ' + 'Tiles groups saved size: ' + str(sum(size for _, size in saved_sizes)) + ' bytes')
+
+            for name, saved_size in saved_sizes:
+                print('        ' + name + ': ' + str(saved_size) + ' bytes')
+
+        print('    ' + 'Graphics files listed in ' + list_milliseconds + ' milliseconds')
+        print('    ' + str(len(graphics_file_infos)) + ' graphics files processed in ' + process_milliseconds +
+              ' milliseconds (' + str(min(jobs, len(graphics_file_infos))) + ' jobs)')
+
+        if len(tiles_groups) > 0:
+            print('    ' + 'Tiles groups processed in ' + tiles_groups_milliseconds + ' milliseconds')
+    else:
+        print('    ' + 'Graphics files not changed. Processing skipped')
+        print('    ' + 'Graphics files listed in ' + elapsed_milliseconds(start) + ' milliseconds')
+
 
 if __name__ == "__main__":
     parser = argparse.ArgumentParser(description='butano graphics tool.')
     parser.add_argument('--graphics', required=True, help='graphics folder paths')
     parser.add_argument('--build', required=True, help='build folder path')
+    parser.add_argument('--jobs', type=int, default=os.cpu_count() or 1,
+                        help='maximum number of graphics files processed at the same time')
+    parser.add_argument('--no-binaries', action='store_true',
+                        help='keep graphics data as assembly directives instead of binary files included with '
+                             '.incbin (already processed graphics files are not processed again)')
 
     try:
         args = parser.parse_args()
-        process(args.graphics, args.build)
+        process(args.graphics, args.build, args.jobs, not args.no_binaries)
     except Exception as ex:
         sys.stderr.write('Error: ' + str(ex) + '\n')
         traceback.print_exc()
@@ -0,0 +1,246 @@
+"""
+Copyright (c) 2020 Gustavo Valiente gustavo.valiente@protonmail.com
+zlib License, see LICENSE file.
+"""
+
+import heapq
+
+
+class Compression:
+
+    types = ['none', 'lz77', 'run_length', 'huffman', 'auto']
+
+    labels = {
+        'none': 'compression_type::NONE',
+        'lz77': 'compression_type::LZ77',
+        'run_length': 'compression_type::RUN_LENGTH',
+        'huffman': 'compression_type::HUFFMAN',
+    }
+
+    @staticmethod
+    def validate(compression):
+        if compression not in Compression.types:
+            raise ValueError('Invalid compression: ' + compression + ' (valid compressions: ' +
+                             ', '.join(Compression.types) + ')')
+
+    @staticmethod
+    def compress(compression, data):
+        if compression == 'lz77':
+            result = Compression.__lz77(data)
+        elif compression == 'run_length':
+            result = Compression.__run_length(data)
+        elif compression == 'huffman':
+            result = Compression.__huffman(data)
+        else:
+            raise ValueError('Invalid compression: ' + compression)
+
+        while len(result) % 4:
+            result.append(0)
+
+        return result
+
+    @staticmethod
+    def __header(compression_id, data):
+        size = len(data)
+        return bytearray([compression_id, size & 0xFF, (size >> 8) & 0xFF, (size >> 16) & 0xFF])
+
+    @staticmethod
+    def __lz77(data):
+        # Displacements lower than 2 are not used to allow VRAM safe decompression (16-bit writes):
+        min_displacement = 2
+        max_displacement = 4096
+        min_length = 3
+        max_length = 18
+        max_candidates = 256
+
+        result = Compression.__header(0x10, data)
+        data_size = len(data)
+        positions = {}
+        index = 0
+
+        def add_position(position):
+            if position + min_length <= data_size:
+                key = bytes(data[position:position + min_length])
+                key_positions = positions.setdefault(key, [])
+                key_positions.append(position)
+
+                if len(key_positions) > max_candidates:
+                    del key_positions[0]
+
+        while index < data_size:
+            flags_index = len(result)
+            result.append(0)
+
+            for block in range(8):
+                if index >= data_size:
+                    break
+
+                best_length = 0
+                best_displacement = 0
+
+                if index + min_length <= data_size:
+                    key = bytes(data[index:index + min_length])
+
+                    for position in reversed(positions.get(key, [])):
+                        displacement = index - position
+
+                        if displacement > max_displacement:
+                            break
+
+                        if displacement < min_displacement:
+                            continue
+
+                        length = min_length
+                        max_block_length = min(max_length, data_size - index)
+
+                        while length < max_block_length and data[position + length] == data[index + length]:
+                            length += 1
+
+                        if length > best_length:
+                            best_length = length
+                            best_displacement = displacement
+
+                            if length == max_block_length:
+                                break
+
+                if best_length >= min_length:
+                    result[flags_index] |= 0x80 >> block
+                    value = ((best_length - min_length) << 12) | (best_displacement - 1)
+                    result.append(value >> 8)
+                    result.append(value & 0xFF)
+                    advance = best_length
+                else:
+                    result.append(data[index])
+                    advance = 1
+
+                for position in range(index, index + advance):
+                    add_position(position)
+
+                index += advance
+
+        return result
+
+    @staticmethod
+    def __run_length(data):
+        min_run_length = 3
+        max_run_length = 130
+        max_raw_length = 128
+
+        result = Compression.__header(0x30, data)
+        data_size = len(data)
+        raw = bytearray()
+        index = 0
+
+        def flush_raw():
+            if raw:
+                result.append(len(raw) - 1)
+                result.extend(raw)
+                raw.clear()
+
+        while index < data_size:
+            run_length = 1
+
+            while index + run_length < data_size and run_length < max_run_length and \
+                    data[index + run_length] == data[index]:
+                run_length += 1
+
+            if run_length >= min_run_length:
+                flush_raw()
+                result.append(0x80 | (run_length - min_run_length))
+                result.append(data[index])
+                index += run_length
+            else:
+                raw.append(data[index])
+                index += 1
+
+                if len(raw) == max_raw_length:
+                    flush_raw()
+
+        flush_raw()
+        return result
+
+    @staticmethod
+    def __huffman(data):
+        # 4-bit symbols, so the tree has 16 leaves at most and all node offsets fit in 6 bits:
+        symbols = []
+
+        for value in data:
+            symbols.append(value & 0xF)
+            symbols.append(value >> 4)
+
+        frequencies = [0] * 16
+
+        for symbol in symbols:
+            frequencies[symbol] += 1
+
+        heap = []
+        order = 0
+
+        for symbol in range(16):
+            if frequencies[symbol]:
+                heap.append((frequencies[symbol], order, symbol))
+                order += 1
+
+        if len(heap) == 1:
+            unused_symbol = 1 if heap[0][2] == 0 else 0
+            heap.append((0, order, unused_symbol))
+            order += 1
+
+        heapq.heapify(heap)
+
+        while len(heap) > 1:
+            first = heapq.heappop(heap)
+            second = heapq.heappop(heap)
+            heapq.heappush(heap, (first[0] + second[0], order, (first[2], second[2])))
+            order += 1
+
+        root = heap[0][2]
+
+        # Tree table, with the root node at offset 1 and the children pairs stored in breadth first order:
+        table = bytearray(2)
+        codes = {}
+        pending = [(root, 1, '')]
+
+        while pending:
+            node, node_offset, code = pending.pop(0)
+            children_offset = len(table)
+            table.extend([0, 0])
+            table[node_offset] = (children_offset - (node_offset & ~1) - 2) >> 1
+
+            for child_index in range(2):
+                child = node[child_index]
+                child_code = code + str(child_index)
+
+                if isinstance(child, tuple):
+                    pending.append((child, children_offset + child_index, child_code))
+                else:
+                    table[node_offset] |= 0x80 >> child_index
+                    table[children_offset + child_index] = child
+                    codes[child] = child_code
+
+        while len(table) % 4:
+            table.append(0)
+
+        table[0] = (len(table) >> 1) - 1
+
+        result = Compression.__header(0x24, data)
+        result.extend(table)
+
+        word = 0
+        word_bits = 0
+
+        for symbol in symbols:
+            for bit in codes[symbol]:
+                word = (word << 1) | int(bit)
+                word_bits += 1
+
+                if word_bits == 32:
+                    result.extend(word.to_bytes(4, 'little'))
+                    word = 0
+                    word_bits = 0
+
+        if word_bits:
+            word <<= 32 - word_bits
+            result.extend(word.to_bytes(4, 'little'))
+
+        return result
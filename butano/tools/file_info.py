@@ -4,6 +4,7 @@ zlib License, see LICENSE file.
 """
 
 import os
+import hashlib
 import string
 
 
@@ -49,10 +50,13 @@ class FileInfo:
     def build_from_files(file_paths):
         info = []
 
+        # Files are identified by their content instead of by their modification time,
+        # so switching branches doesn't trigger a rebuild if they have not changed:
         for file_path in file_paths:
             info.append(file_path)
-            info.append(str(os.path.getsize(file_path)))
-            info.append(str(os.path.getmtime(file_path)))
+
+            with open(file_path, 'rb') as file:
+                info.append(hashlib.sha1(file.read()).hexdigest())
 
         return FileInfo('\n'.join(info), False)
 
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2020 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_core.h"
+#include "bn_math.h"
+#include "bn_memory.h"
+#include "bn_string.h"
+#include "bn_keypad.h"
+#include "bn_random.h"
+#include "bn_bg_palettes.h"
+#include "bn_sprite_text_generator.h"
+#include "bn_sprite_particle_emitter.h"
+
+#include "bn_sprite_items_particle.h"
+
+#include "info.h"
+#include "variable_8x16_sprite_font.h"
+
+namespace
+{
+    void particles_stress_scene(bn::sprite_text_generator& text_generator)
+    {
+        constexpr const bn::string_view info_text_lines[] = {
+            "UP: increase emission rate",
+            "DOWN: decrease emission rate",
+            "A: auto adjust emission rate",
+            "",
+            "START: go to next scene",
+        };
+
+        info info("Sprite particles stress", info_text_lines, text_generator);
+
+        // The emitter doesn't fit in the stack, so it is allocated in the heap:
+        bn::unique_ptr<bn::sprite_particle_emitter<2048>> emitter(
+                new bn::sprite_particle_emitter<2048>(bn::sprite_items::particle));
+        emitter->set_acceleration(bn::fixed_point(0, 0.02));
+        emitter->set_frame_wait_updates(12);
+
+        bn::random random;
+        bn::vector<bn::sprite_ptr, 8> text_sprites;
+        bn::fixed max_cpu_usage;
+        int emission_rate = 8;
+        int max_particles = 0;
+        int counter = 1;
+        bool auto_adjust = true;
+
+        while(! bn::keypad::start_pressed())
+        {
+            if(bn::keypad::up_pressed())
+            {
+                ++emission_rate;
+                auto_adjust = false;
+            }
+            else if(bn::keypad::down_pressed())
+            {
+                emission_rate = bn::max(emission_rate - 1, 0);
+                auto_adjust = false;
+            }
+            else if(bn::keypad::a_pressed())
+            {
+                auto_adjust = true;
+            }
+
+            bn::fixed cpu_usage = bn::core::last_cpu_usage();
+            max_cpu_usage = bn::max(max_cpu_usage, cpu_usage);
+
+            if(cpu_usage < 1)
+            {
+                // Particles alive in a frame which fitted in one V-Blank period:
+                max_particles = bn::max(max_particles, emitter->size());
+            }
+
+            if(auto_adjust)
+            {
+                if(cpu_usage < bn::fixed(0.9))
+                {
+                    ++emission_rate;
+                }
+                else if(emission_rate)
+                {
+                    --emission_rate;
+                }
+            }
+
+            for(int index = 0; index < emission_rate; ++index)
+            {
+                int angle = int(random.get() % 512);
+                bn::fixed speed = bn::fixed::from_data(int(random.get() % 8192) + 2048);
+                bn::fixed_point velocity(bn::lut_cos(angle) * speed, bn::lut_sin(angle) * speed);
+                int lifetime = int(random.get() % 32) + 40;
+
+                if(! emitter->emit(bn::fixed_point(0, -16), velocity, lifetime))
+                {
+                    break;
+                }
+            }
+
+            emitter->update();
+            --counter;
+
+            if(! counter)
+            {
+                bn::string<32> text;
+                bn::ostringstream text_stream(text);
+                text_sprites.clear();
+
+                text_stream.append("Particles: ");
+                text_stream.append(emitter->size());
+                text_generator.generate(-104, -40, text, text_sprites);
+                text.clear();
+
+                text_stream.append("Max in one frame: ");
+                text_stream.append(max_particles);
+                text_generator.generate(-104, -24, text, text_sprites);
+                text.clear();
+
+                text_stream.append("CPU: ");
+                text_stream.append((max_cpu_usage * 100).right_shift_integer());
+                text_stream.append("%");
+                text_generator.generate(-104, -8, text, text_sprites);
+
+                max_cpu_usage = 0;
+                counter = 30;
+            }
+
+            info.update();
+            bn::core::update();
+        }
+    }
+}
+
+int main()
+{
+    bn::core::init();
+
+    bn::sprite_text_generator text_generator(variable_8x16_sprite_font);
+    bn::bg_palettes::set_transparent_color(bn::color(2, 2, 4));
+
+    while(true)
+    {
+        particles_stress_scene(text_generator);
+        bn::core::update();
+    }
+}
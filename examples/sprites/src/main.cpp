@@ -15,6 +15,7 @@
 #include "bn_sprite_builder.h"
 #include "bn_sprite_text_generator.h"
 #include "bn_sprite_animate_actions.h"
+#include "bn_sprite_delta_animate_action.h"
 #include "bn_sprite_first_attributes.h"
 #include "bn_sprite_third_attributes.h"
 #include "bn_sprite_position_hbe_ptr.h"
@@ -270,6 +271,29 @@ namespace
         }
     }
 
+    void sprites_delta_animation_action_scene(bn::sprite_text_generator& text_generator)
+    {
+        constexpr const bn::string_view info_text_lines[] = {
+            "Only the tiles which change",
+            "between frames are uploaded",
+            "",
+            "START: go to next scene",
+        };
+
+        info info("Sprites delta animation action", info_text_lines, text_generator);
+
+        bn::sprite_ptr ninja_sprite = bn::sprite_items::ninja.create_sprite(0, 0);
+        bn::sprite_delta_animate_action action = bn::sprite_delta_animate_action::forever(
+                    ninja_sprite, 16, bn::sprite_tiles_delta_items::ninja);
+
+        while(! bn::keypad::start_pressed())
+        {
+            action.update();
+            info.update();
+            bn::core::update();
+        }
+    }
+
     void sprites_rotation_scene(bn::sprite_text_generator& text_generator)
     {
         constexpr const bn::string_view info_text_lines[] = {
@@ -1047,6 +1071,9 @@ int main()
         sprites_animation_actions_scene(text_generator);
         bn::core::update();
 
+        sprites_delta_animation_action_scene(text_generator);
+        bn::core::update();
+
         sprites_rotation_scene(text_generator);
         bn::core::update();
 
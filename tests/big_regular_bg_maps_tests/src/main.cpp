@@ -3,10 +3,17 @@
  * zlib License, see LICENSE file.
  */
 
+#include "bn_bgs.h"
 #include "bn_core.h"
 #include "bn_keypad.h"
 #include "bn_display.h"
+#include "bn_profiler.h"
+#include "bn_config_bg_blocks.h"
+#include "bn_bg_palette_ptr.h"
 #include "bn_regular_bg_ptr.h"
+#include "bn_regular_bg_builder.h"
+#include "bn_regular_bg_map_ptr.h"
+#include "bn_regular_bg_tiles_ptr.h"
 #include "bn_sprite_text_generator.h"
 
 #include "info.h"
@@ -17,19 +24,23 @@
 
 namespace
 {
-    void big_map_scene(const bn::string_view& title, const bn::regular_bg_item& item,
+    void big_map_scene(const bn::string_view& title, const bn::regular_bg_item& item, int cache_tiles_count,
                        bn::sprite_text_generator& text_generator)
     {
         constexpr const bn::string_view info_text_lines[] = {
             "PAD: move BG",
             "A: move BG faster",
+            "B: teleport BG",
+            "L: change redraw mode",
             "",
             "START: go to next scene",
         };
 
         info info(title, info_text_lines, text_generator);
 
-        bn::regular_bg_ptr bg = item.create_bg(0, 0);
+        // Tiles are streamed to a cache of allocated tiles if cache_tiles_count is not zero:
+        bn::regular_bg_ptr bg = cache_tiles_count ?
+                    item.create_bg_with_tiles_cache(0, 0, cache_tiles_count) : item.create_bg(0, 0);
         int x_limit = (bg.dimensions().width() - bn::display::width()) / 2;
         int y_limit = (bg.dimensions().height() - bn::display::height()) / 2;
 
@@ -37,6 +48,31 @@ namespace
         {
             int inc = bn::keypad::a_held() ? 8 : 1;
 
+            if(bn::keypad::b_pressed())
+            {
+                // Jumps to the opposite corner, so the whole visible area must be redrawn:
+                bg.set_position(bg.x() > 0 ? 1 - x_limit : x_limit, bg.y() > 0 ? 1 - y_limit : y_limit);
+            }
+
+            if(bn::keypad::l_pressed())
+            {
+                switch(bn::bgs::big_maps_redraw_mode())
+                {
+
+                case bn::big_map_redraw_mode::IMMEDIATE:
+                    bn::bgs::set_big_maps_redraw_mode(bn::big_map_redraw_mode::PROGRESSIVE);
+                    break;
+
+                case bn::big_map_redraw_mode::PROGRESSIVE:
+                    bn::bgs::set_big_maps_redraw_mode(bn::big_map_redraw_mode::PROGRESSIVE_HIDDEN);
+                    break;
+
+                default:
+                    bn::bgs::set_big_maps_redraw_mode(bn::big_map_redraw_mode::IMMEDIATE);
+                    break;
+                }
+            }
+
             if(bn::keypad::left_held())
             {
                 bg.set_x(bn::max(bg.x().right_shift_integer() - inc, 1 - x_limit));
@@ -59,6 +95,76 @@ namespace
             bn::core::update();
         }
     }
+
+    [[nodiscard]] bn::regular_bg_ptr create_palette_offset_bg(const bn::regular_bg_item& item,
+                                                              bn::optional<bn::bg_palette_ptr>& first_palette)
+    {
+        // The BG palette is not the first one, so its map cells are copied with a palette offset:
+        first_palette = item.palette_item().create_new_palette();
+
+        bn::regular_bg_map_ptr map = bn::regular_bg_map_ptr::create(
+                    item.map_item(), item.tiles_item().create_tiles(), item.palette_item().create_new_palette());
+        return bn::regular_bg_ptr::create(bn::regular_bg_builder(bn::move(map)));
+    }
+
+    void diagonal_scroll_scene(const bn::string_view& title, const bn::regular_bg_item& item, bool palette_offset,
+                               bn::sprite_text_generator& text_generator)
+    {
+        constexpr const bn::string_view info_text_lines[] = {
+            "A: change scroll speed",
+            "SELECT: show profiler results",
+            "(if the profiler is enabled)",
+            "",
+            "START: go to next scene",
+        };
+
+        info info(title, info_text_lines, text_generator);
+
+        bn::optional<bn::bg_palette_ptr> first_palette;
+        bn::regular_bg_ptr bg = palette_offset ? create_palette_offset_bg(item, first_palette) : item.create_bg(0, 0);
+        int x_limit = (bg.dimensions().width() - bn::display::width()) / 2;
+        int y_limit = (bg.dimensions().height() - bn::display::height()) / 2;
+        int speed = 2;
+        int x_inc = 1;
+        int y_inc = 1;
+        BN_PROFILER_RESET();
+
+        while(! bn::keypad::start_pressed())
+        {
+            if(bn::keypad::a_pressed())
+            {
+                speed = speed == 8 ? 1 : speed * 2;
+            }
+
+            // A new column and a new row are committed each time a cell boundary is crossed:
+            int x = bg.x().right_shift_integer() + (x_inc * speed);
+            int y = bg.y().right_shift_integer() + (y_inc * speed);
+
+            if(x <= 1 - x_limit || x >= x_limit)
+            {
+                x = bn::max(bn::min(x, x_limit), 1 - x_limit);
+                x_inc = -x_inc;
+            }
+
+            if(y <= 1 - y_limit || y >= y_limit)
+            {
+                y = bn::max(bn::min(y, y_limit), 1 - y_limit);
+                y_inc = -y_inc;
+            }
+
+            bg.set_position(x, y);
+
+            #if BN_CFG_PROFILER_ENABLED
+                if(bn::keypad::select_pressed())
+                {
+                    bn::profiler::show();
+                }
+            #endif
+
+            info.update();
+            bn::core::update();
+        }
+    }
 }
 
 int main()
@@ -69,10 +175,28 @@ int main()
 
     while(true)
     {
-        big_map_scene("1024x512 BPP8 regular BG", bn::regular_bg_items::big_map_8, text_generator);
+        big_map_scene("1024x512 BPP8 regular BG", bn::regular_bg_items::big_map_8, 0, text_generator);
+        bn::core::update();
+
+        big_map_scene("1280x768 BPP4 regular BG", bn::regular_bg_items::big_map_4, 0, text_generator);
+        bn::core::update();
+
+        #if BN_CFG_BG_BLOCKS_MAX_TILES_CACHES
+            // The BG has more than 900 tiles, but a 32x32 area of it references less than 320:
+            big_map_scene("1280x768 BPP4 tiles cache", bn::regular_bg_items::big_map_4, 384, text_generator);
+            bn::core::update();
+        #endif
+
+        diagonal_scroll_scene("1024x512 BPP8 diagonal scroll", bn::regular_bg_items::big_map_8, false,
+                              text_generator);
+        bn::core::update();
+
+        diagonal_scroll_scene("1280x768 BPP4 diagonal scroll", bn::regular_bg_items::big_map_4, false,
+                              text_generator);
         bn::core::update();
 
-        big_map_scene("1280x768 BPP4 regular BG", bn::regular_bg_items::big_map_4, text_generator);
+        diagonal_scroll_scene("BPP4 palette offset diagonal scroll", bn::regular_bg_items::big_map_4, true,
+                              text_generator);
         bn::core::update();
     }
 }
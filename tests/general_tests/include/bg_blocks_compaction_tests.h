@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2020 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BG_BLOCKS_COMPACTION_TESTS_H
+#define BG_BLOCKS_COMPACTION_TESTS_H
+
+#include "bn_core.h"
+#include "bn_optional.h"
+#include "bn_size.h"
+#include "bn_bg_tiles.h"
+#include "bn_bg_palette_ptr.h"
+#include "bn_bg_palette_item.h"
+#include "bn_regular_bg_map_ptr.h"
+#include "bn_regular_bg_tiles_ptr.h"
+#include "bn_regular_bg_tiles_item.h"
+#include "tests.h"
+
+class bg_blocks_compaction_tests : public tests
+{
+
+public:
+    bg_blocks_compaction_tests() :
+        tests("bg_blocks_compaction")
+    {
+        bn::optional<bn::regular_bg_tiles_ptr> first_tiles =
+                bn::regular_bg_tiles_ptr::create_new(bn::regular_bg_tiles_item(_first_tiles, bn::bpp_mode::BPP_4));
+        bn::regular_bg_tiles_ptr second_tiles =
+                bn::regular_bg_tiles_ptr::create_new(bn::regular_bg_tiles_item(_second_tiles, bn::bpp_mode::BPP_4));
+        bn::bg_palette_ptr palette = bn::bg_palette_ptr::create_new(
+                bn::bg_palette_item(_colors, bn::bpp_mode::BPP_4));
+        bn::optional<bn::regular_bg_map_ptr> map = bn::regular_bg_map_ptr::allocate(
+                bn::size(32, 32), second_tiles, palette);
+
+        int first_tiles_id = first_tiles->id();
+        int second_tiles_id = second_tiles.id();
+        BN_ASSERT(first_tiles_id < second_tiles_id, "Invalid tiles ids: ", first_tiles_id, " - ", second_tiles_id);
+
+        // Tiles referenced by an allocated map can't change their offset:
+        first_tiles.reset();
+        _compact();
+        BN_ASSERT(second_tiles.id() == second_tiles_id, "Invalid tiles id: ", second_tiles.id());
+
+        // Without the allocated map they can be moved:
+        map.reset();
+        _compact();
+        BN_ASSERT(second_tiles.id() < second_tiles_id, "Invalid tiles id: ", second_tiles.id());
+    }
+
+private:
+    static constexpr bn::tile _first_tiles[64] = {};
+    static constexpr bn::tile _second_tiles[64] = {};
+    static constexpr bn::color _colors[16] = {};
+
+    static void _compact()
+    {
+        bn::core::update();
+        bn::bg_tiles::compact();
+
+        while(bn::bg_tiles::compacting())
+        {
+            bn::core::update();
+        }
+    }
+};
+
+#endif
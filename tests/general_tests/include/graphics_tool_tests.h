@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2020 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef GRAPHICS_TOOL_TESTS_H
+#define GRAPHICS_TOOL_TESTS_H
+
+#include "bn_sprite_items_tool_sprite.h"
+#include "bn_sprite_items_tool_delta_sprite.h"
+#include "bn_regular_bg_items_tool_bg_a.h"
+#include "bn_regular_bg_items_tool_bg_b.h"
+#include "bn_regular_bg_items_tool_big_bg.h"
+#include "bn_regular_bg_items_tool_metatiles_bg.h"
+#include "bn_regular_bg_items_tool_group_bg_a.h"
+#include "bn_regular_bg_items_tool_group_bg_b.h"
+#include "bn_sprite_items_tool_sprite_lz77.h"
+#include "../../../butano/hw/include/bn_hw_decompress.h"
+#include "tests.h"
+
+// Graphics are processed with grit, so these tests check that the whole grit output is read by the graphics tool
+// (grit writes a blank line after every 8 data lines):
+class graphics_tool_tests : public tests
+{
+
+public:
+    graphics_tool_tests() :
+        tests("graphics_tool")
+    {
+        _compressed_sprite_tests();
+        _delta_sprite_tests();
+        _bg_tiles_group_tests(bn::regular_bg_items::tool_group_bg_a, bn::regular_bg_items::tool_bg_a);
+        _bg_tiles_group_tests(bn::regular_bg_items::tool_group_bg_b, bn::regular_bg_items::tool_bg_b);
+        _column_major_map_tests();
+        _metatiles_map_tests();
+    }
+
+private:
+    [[nodiscard]] static bool _equal_tiles(const bn::tile& a, const bn::tile& b)
+    {
+        for(int index = 0; index < 8; ++index)
+        {
+            if(a.data[index] != b.data[index])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    [[nodiscard]] static int _pixel(const bn::span<const bn::tile>& tiles, bn::regular_bg_map_cell cell, int x, int y)
+    {
+        if(cell & 0x0400)
+        {
+            x = 7 - x;
+        }
+
+        if(cell & 0x0800)
+        {
+            y = 7 - y;
+        }
+
+        return (tiles[cell & 0x03FF].data[y] >> (x * 4)) & 15;
+    }
+
+    [[nodiscard]] static bool _equal_cells(const bn::span<const bn::tile>& a_tiles, bn::regular_bg_map_cell a_cell,
+                                           const bn::span<const bn::tile>& b_tiles, bn::regular_bg_map_cell b_cell)
+    {
+        for(int y = 0; y < 8; ++y)
+        {
+            for(int x = 0; x < 8; ++x)
+            {
+                if(_pixel(a_tiles, a_cell, x, y) != _pixel(b_tiles, b_cell, x, y))
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    static void _compressed_sprite_tests()
+    {
+        const bn::sprite_tiles_item& tiles_item = bn::sprite_items::tool_sprite.tiles_item();
+        const bn::sprite_tiles_item& compressed_tiles_item = bn::sprite_items::tool_sprite_lz77.tiles_item();
+        int tiles_count = tiles_item.tiles_count_per_graphic();
+        BN_ASSERT(compressed_tiles_item.compression() == bn::compression_type::LZ77);
+        BN_ASSERT(compressed_tiles_item.graphics_count() == tiles_item.graphics_count());
+        BN_ASSERT(compressed_tiles_item.tiles_count_per_graphic() == tiles_count);
+        BN_ASSERT(tiles_count == 16, "Invalid tiles count: ", tiles_count);
+
+        for(int graphics_index = 0; graphics_index < tiles_item.graphics_count(); ++graphics_index)
+        {
+            bn::span<const bn::tile> tiles = tiles_item.graphics_tiles_ref(graphics_index);
+            bn::span<const bn::tile> compressed_tiles = compressed_tiles_item.graphics_tiles_ref(graphics_index);
+            BN_ASSERT(bn::hw::decompress::decompressed_size(compressed_tiles.data()) == tiles.size_bytes(),
+                      "Invalid decompressed size: ", bn::hw::decompress::decompressed_size(compressed_tiles.data()));
+
+            bn::tile decompressed_tiles[16];
+            bn::hw::decompress::lz77_vram(compressed_tiles.data(), decompressed_tiles);
+
+            for(int tile_index = 0; tile_index < tiles_count; ++tile_index)
+            {
+                BN_ASSERT(_equal_tiles(decompressed_tiles[tile_index], tiles[tile_index]),
+                          "Invalid decompressed tile: ", graphics_index, " - ", tile_index);
+            }
+        }
+    }
+
+    static void _delta_sprite_tests()
+    {
+        const bn::sprite_tiles_item& tiles_item = bn::sprite_items::tool_delta_sprite.tiles_item();
+        const bn::sprite_tiles_delta_item& delta_item = bn::sprite_tiles_delta_items::tool_delta_sprite;
+        int tiles_count = delta_item.tiles_count_per_graphic();
+        BN_ASSERT(tiles_count == tiles_item.tiles_count_per_graphic(), "Invalid tiles count: ", tiles_count);
+        BN_ASSERT(tiles_count == 8, "Invalid tiles count: ", tiles_count);
+        BN_ASSERT(delta_item.graphics_count() == tiles_item.graphics_count(),
+                  "Invalid graphics count: ", delta_item.graphics_count());
+
+        // Deltas are applied to a double buffer, as sprite_delta_animate_action does:
+        bn::tile frames[2][8];
+
+        for(int delta_index = 0; delta_index < delta_item.deltas_count(); ++delta_index)
+        {
+            bn::span<const bn::tile> delta_tiles = delta_item.delta_tiles_ref(delta_index);
+            bn::span<const uint8_t> delta_tile_indexes = delta_item.delta_tile_indexes_ref(delta_index);
+            bn::tile* frame = frames[delta_index % 2];
+
+            if(delta_index < 2)
+            {
+                BN_ASSERT(delta_tiles.size() == tiles_count, "Invalid delta tiles count: ", delta_tiles.size());
+            }
+
+            for(int index = 0, limit = delta_tiles.size(); index < limit; ++index)
+            {
+                frame[delta_tile_indexes[index]] = delta_tiles[index];
+            }
+
+            int graphics_index = delta_index % tiles_item.graphics_count();
+            bn::span<const bn::tile> tiles = tiles_item.graphics_tiles_ref(graphics_index);
+
+            for(int tile_index = 0; tile_index < tiles_count; ++tile_index)
+            {
+                BN_ASSERT(_equal_tiles(frame[tile_index], tiles[tile_index]),
+                          "Invalid delta tile: ", delta_index, " - ", tile_index);
+            }
+        }
+    }
+
+    static void _bg_tiles_group_tests(const bn::regular_bg_item& group_item, const bn::regular_bg_item& item)
+    {
+        // Every map cell must be remapped to a tiles group tile with the same pixels:
+        const bn::regular_bg_map_item& group_map_item = group_item.map_item();
+        const bn::regular_bg_map_item& map_item = item.map_item();
+        bn::span<const bn::tile> group_tiles = group_item.tiles_item().tiles_ref();
+        bn::span<const bn::tile> tiles = item.tiles_item().tiles_ref();
+        const bn::regular_bg_map_cell* group_cells = &group_map_item.cells_ref();
+        const bn::regular_bg_map_cell* cells = &map_item.cells_ref();
+        BN_ASSERT(group_map_item.dimensions() == map_item.dimensions());
+
+        for(int index = 0, limit = map_item.dimensions().width() * map_item.dimensions().height(); index < limit;
+            ++index)
+        {
+            BN_ASSERT(_equal_cells(group_tiles, group_cells[index], tiles, cells[index]),
+                      "Invalid tiles group cell: ", index);
+        }
+    }
+
+    static void _column_major_map_tests()
+    {
+        const bn::regular_bg_map_item& map_item = bn::regular_bg_items::tool_big_bg.map_item();
+        const bn::regular_bg_map_cell* cells = &map_item.cells_ref();
+        const bn::regular_bg_map_cell* column_major_cells = map_item.column_major_cells_ptr();
+        int width = map_item.dimensions().width();
+        int height = map_item.dimensions().height();
+        BN_ASSERT(column_major_cells);
+        BN_ASSERT(width == 128 && height == 32, "Invalid dimensions: ", width, " - ", height);
+
+        for(int x = 0; x < width; ++x)
+        {
+            for(int y = 0; y < height; ++y)
+            {
+                BN_ASSERT(column_major_cells[(x * height) + y] == cells[(y * width) + x],
+                          "Invalid column-major cell: ", x, " - ", y);
+            }
+        }
+    }
+
+    static void _metatiles_map_tests()
+    {
+        // Both BGs are built from the same image, so the expanded metatiles must match the cells of the other one:
+        const bn::regular_bg_map_item& map_item = bn::regular_bg_items::tool_big_bg.map_item();
+        const bn::regular_bg_map_item& metatiles_map_item = bn::regular_bg_items::tool_metatiles_bg.map_item();
+        const bn::regular_bg_map_cell* cells = &map_item.cells_ref();
+        const uint16_t* metatile_indexes = &metatiles_map_item.cells_ref();
+        const bn::regular_bg_map_cell* metatiles_cells = metatiles_map_item.metatiles_cells_ptr();
+        int metatile_size = metatiles_map_item.metatile_size();
+        int width = map_item.dimensions().width();
+        int height = map_item.dimensions().height();
+        int metatiles_width = width / metatile_size;
+        BN_ASSERT(metatiles_cells);
+        BN_ASSERT(metatile_size == 2, "Invalid metatile size: ", metatile_size);
+        BN_ASSERT(metatiles_map_item.dimensions() == map_item.dimensions());
+
+        for(int y = 0; y < height; ++y)
+        {
+            for(int x = 0; x < width; ++x)
+            {
+                int metatile_index = metatile_indexes[((y / metatile_size) * metatiles_width) + (x / metatile_size)];
+                int cell_index = (metatile_index * metatile_size * metatile_size) +
+                        ((y % metatile_size) * metatile_size) + (x % metatile_size);
+                BN_ASSERT(metatiles_cells[cell_index] == cells[(y * width) + x],
+                          "Invalid metatile cell: ", x, " - ", y);
+            }
+        }
+    }
+};
+
+#endif
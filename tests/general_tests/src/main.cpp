@@ -17,6 +17,8 @@
 #include "any_tests.h"
 #include "malloc_tests.h"
 #include "sram_tests.h"
+#include "bg_blocks_compaction_tests.h"
+#include "graphics_tool_tests.h"
 #include "variable_8x16_sprite_font.h"
 
 #if ! BN_CFG_ASSERT_ENABLED
@@ -39,6 +41,8 @@ int main()
     sqrt_tests();
     any_tests();
     malloc_tests();
+    bg_blocks_compaction_tests();
+    graphics_tool_tests();
     sram_tests sram_tests;
 
     if(sram_tests.again())
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2020 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_core.h"
+#include "bn_math.h"
+#include "bn_timer.h"
+#include "bn_keypad.h"
+#include "bn_random.h"
+#include "bn_string.h"
+#include "bn_optional.h"
+#include "bn_sprite_tiles.h"
+#include "bn_sprite_tiles_ptr.h"
+#include "bn_sprite_text_generator.h"
+
+#include "info.h"
+#include "variable_8x16_sprite_font.h"
+
+namespace
+{
+    void churn_scene(bn::sprite_text_generator& text_generator)
+    {
+        constexpr const bn::string_view info_text_lines[] = {
+            "UP: increase operations",
+            "DOWN: decrease operations",
+            "",
+            "START: restart",
+        };
+
+        info info("Sprite tiles churn", info_text_lines, text_generator);
+
+        bn::vector<bn::sprite_tiles_ptr, 64> tiles;
+        bn::vector<bn::sprite_ptr, 16> text_sprites;
+        bn::random random;
+        bn::timer timer;
+        int operations_per_frame = 32;
+        int operations = 0;
+        int failed_operations = 0;
+        int ticks = 0;
+        int counter = 1;
+
+        while(! bn::keypad::start_pressed())
+        {
+            if(bn::keypad::up_pressed())
+            {
+                operations_per_frame += 8;
+            }
+            else if(bn::keypad::down_pressed())
+            {
+                operations_per_frame = bn::max(operations_per_frame - 8, 8);
+            }
+
+            timer.restart();
+
+            for(int index = 0; index < operations_per_frame; ++index)
+            {
+                // Create and destroy blocks of 1, 2, 4 and 8 tiles, like short animations do:
+                if(tiles.full() || (! tiles.empty() && random.get() % 2))
+                {
+                    tiles.erase(tiles.begin() + int(random.get() % unsigned(tiles.size())));
+                }
+                else
+                {
+                    int tiles_count = 1 << int(random.get() % 4);
+
+                    if(bn::optional<bn::sprite_tiles_ptr> tiles_ptr =
+                            bn::sprite_tiles_ptr::allocate_optional(tiles_count, bn::bpp_mode::BPP_4))
+                    {
+                        tiles.push_back(bn::move(*tiles_ptr));
+                    }
+                    else
+                    {
+                        ++failed_operations;
+                    }
+                }
+            }
+
+            ticks += timer.elapsed_ticks();
+            operations += operations_per_frame;
+            --counter;
+
+            if(! counter)
+            {
+                bn::string<32> text;
+                bn::ostringstream text_stream(text);
+                text_sprites.clear();
+
+                text_stream.append("Ticks per operation: ");
+                text_stream.append(ticks / operations);
+                text_generator.generate(0, -24, text, text_sprites);
+                text.clear();
+
+                text_stream.append("Operations per frame: ");
+                text_stream.append(operations_per_frame);
+                text_generator.generate(0, -8, text, text_sprites);
+                text.clear();
+
+                text_stream.append("Failed: ");
+                text_stream.append(failed_operations);
+                text_stream.append(" Used tiles: ");
+                text_stream.append(bn::sprite_tiles::used_tiles_count());
+                text_generator.generate(0, 8, text, text_sprites);
+
+                operations = 0;
+                failed_operations = 0;
+                ticks = 0;
+                counter = 60;
+            }
+
+            info.update();
+            bn::core::update();
+        }
+    }
+}
+
+int main()
+{
+    bn::core::init();
+
+    bn::sprite_text_generator text_generator(variable_8x16_sprite_font);
+
+    while(true)
+    {
+        churn_scene(text_generator);
+        bn::core::update();
+    }
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2020 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_core.h"
+#include "bn_math.h"
+#include "bn_random.h"
+#include "bn_vector.h"
+#include "bn_profiler.h"
+#include "bn_display.h"
+#include "bn_fixed_point.h"
+#include "bn_camera_ptr.h"
+#include "bn_sprite_ptr.h"
+
+#include "bn_sprite_items_variable_8x16_font.h"
+
+namespace
+{
+    constexpr const int sprites_count = 128;
+    constexpr const int frames_count = 600;
+
+    // Sprites are wrapped a bit outside of the screen, so they enter and leave it continuously:
+    constexpr const int max_x = (bn::display::width() / 2) + 16;
+    constexpr const int max_y = (bn::display::height() / 2) + 16;
+
+    [[nodiscard]] bn::fixed wrap(bn::fixed value, int max_value)
+    {
+        if(value > max_value)
+        {
+            value -= max_value * 2;
+        }
+        else if(value < -max_value)
+        {
+            value += max_value * 2;
+        }
+
+        return value;
+    }
+}
+
+int main()
+{
+    bn::core::init();
+
+    // Half of the sprites are attached to a moving camera, so both the culling and the camera passes of
+    // eng_sprites_update are measured:
+    bn::camera_ptr camera = bn::camera_ptr::create(0, 0);
+    bn::vector<bn::sprite_ptr, sprites_count> sprites;
+    bn::vector<bn::fixed_point, sprites_count> velocities;
+    bn::random random;
+    const bn::sprite_item& sprite_item = bn::sprite_items::variable_8x16_font;
+    int graphics_count = sprite_item.tiles_item().graphics_count();
+
+    for(int index = 0; index < sprites_count; ++index)
+    {
+        bn::fixed x = int(random.get() % unsigned(max_x * 2)) - max_x;
+        bn::fixed y = int(random.get() % unsigned(max_y * 2)) - max_y;
+        bn::sprite_ptr sprite = sprite_item.create_sprite(x, y, index % graphics_count);
+
+        if(index % 2)
+        {
+            sprite.set_camera(camera);
+        }
+
+        sprites.push_back(bn::move(sprite));
+        velocities.emplace_back(bn::fixed(int(random.get() % 9) - 4) / 2, bn::fixed(int(random.get() % 9) - 4) / 2);
+    }
+
+    // Profiler results are shown after 10 seconds:
+    for(int frame = 0; frame < frames_count; ++frame)
+    {
+        for(int index = 0; index < sprites_count; ++index)
+        {
+            bn::sprite_ptr& sprite = sprites[index];
+            bn::fixed_point position = sprite.position() + velocities[index];
+            sprite.set_position(wrap(position.x(), max_x), wrap(position.y(), max_y));
+        }
+
+        camera.set_position(bn::lut_sin(frame % 512) * 32, bn::lut_cos(frame % 512) * 32);
+        bn::core::update();
+    }
+
+    bn::profiler::show();
+}